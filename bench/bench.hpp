@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace bench {
+
+// Не даёт компилятору выбросить вычисление результата
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Счётчик тактов процессора, ноль на платформах без него
+inline std::uint64_t read_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// Время и число тактов лучшего из прогонов
+struct measurement {
+    double seconds = 0;
+    std::uint64_t cycles = 0;
+};
+
+// Многократно выполняет fn и возвращает лучший прогон
+template <typename F>
+measurement measure(F&& fn, int repeats = 5) {
+    measurement best;
+    for (int i = 0; i < repeats; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        const std::uint64_t start_cycles = read_cycles();
+        fn();
+        const std::uint64_t cycles = read_cycles() - start_cycles;
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (i == 0 || elapsed.count() < best.seconds) {
+            best = {elapsed.count(), cycles};
+        }
+    }
+    return best;
+}
+
+// Печатает результат замера одной строкой: время, MB/s, записи в секунду и такты на байт
+inline void report(std::string_view suite, std::string_view name, const measurement& result, std::size_t bytes,
+                   std::size_t records = 0) {
+    std::printf("%-10.*s %-48.*s %10.3f ms %10.1f MB/s", static_cast<int>(suite.size()), suite.data(),
+        static_cast<int>(name.size()), name.data(), result.seconds * 1e3,
+        static_cast<double>(bytes) / result.seconds / 1e6);
+    if (records != 0) {
+        std::printf(" %10.2f Mrec/s", static_cast<double>(records) / result.seconds / 1e6);
+    }
+    if (result.cycles != 0) {
+        std::printf(" %8.2f cycles/B", static_cast<double>(result.cycles) / static_cast<double>(bytes));
+    }
+    std::printf("\n");
+}
+
+// Наборы бенчмарков
+void run_search_benchmarks();
+void run_integer_benchmarks();
+void run_floating_benchmarks();
+void run_parallel_benchmarks();
+void run_formats_benchmarks();
+
+} // namespace bench
@@ -0,0 +1,264 @@
+// Замер стоимости компиляции: генерирует единицы трансляции с разным числом плейсхолдеров,
+// длиной разбираемой строки и числом форматов, компилирует каждую и сравнивает время
+// и пиковую память компилятора с сохранённым базовым уровнем.
+//
+// Запуск: scan_compile_bench --compiler <path> --include <dir> --work <dir> --baseline <file>
+//                            [--tolerance 0.25] [--repeats 3] [--update] [-- <флаги компилятора>...]
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Абсолютные пороги, ниже которых разница считается шумом
+constexpr double TIME_NOISE_SECONDS = 0.05;
+constexpr long MEMORY_NOISE_KB = 8 * 1024;
+
+struct options {
+    std::string compiler;
+    std::string include;
+    std::filesystem::path work;
+    std::filesystem::path baseline;
+    double tolerance = 0.25;
+    int repeats = 3;
+    bool update = false;
+    std::vector<std::string> flags;
+};
+
+// Сгенерированная единица трансляции
+struct test_case {
+    std::string name;
+    std::string source;
+};
+
+// Результат замера: лучшее время и наибольшая пиковая память за все прогоны
+struct cost {
+    double seconds = 0;
+    long max_rss_kb = 0;
+};
+
+const std::string PRELUDE =
+    "#include \"scan.hpp\"\n"
+    "#include <string_view>\n"
+    "using namespace stdx::details::literals;\n";
+
+std::string repeat(std::size_t count, const std::string& item, const std::string& separator) {
+    std::string result;
+    for (std::size_t i = 0; i < count; ++i) {
+        result += (i == 0 ? "" : separator) + item;
+    }
+    return result;
+}
+
+// Разбор в compile-time строки из count беззнаковых полей
+test_case make_placeholders_case(std::size_t count) {
+    std::string values;
+    for (std::size_t i = 0; i < count; ++i) {
+        values += (i == 0 ? "" : ",") + std::to_string(i);
+    }
+    return {"placeholders_" + std::to_string(count),
+            PRELUDE + "constexpr auto result = stdx::scan<\"" + repeat(count, "{%u}", ",") + "\"_fs, \"" + values +
+                "\", " + repeat(count, "unsigned", ", ") + ">();\n"
+                "static_assert(std::get<0>(result.values()) == 0);\n"};
+}
+
+// Разбор в compile-time строки длиной около length байт
+test_case make_source_case(std::size_t length) {
+    return {"source_" + std::to_string(length),
+            PRELUDE + "constexpr auto result = stdx::scan<\"{%s};{%u}\"_fs, \"" + std::string(length, 'a') +
+                ";42\", std::string_view, unsigned>();\n"
+                "static_assert(std::get<1>(result.values()) == 42);\n"};
+}
+
+// count различных форматов: таблица конфигурации, разобранная в compile-time, и runtime-разбор
+test_case make_formats_case(std::size_t count) {
+    std::string source = PRELUDE;
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::string key = "key" + std::to_string(i);
+        source += "constexpr auto config_" + std::to_string(i) + " = stdx::scan<\"" + key + "={%u} name={%s}\"_fs, \"" +
+                  key + "=" + std::to_string(i) + " name=value\", unsigned, std::string_view>();\n";
+        source += "auto scan_" + std::to_string(i) + "(std::string_view input) { return stdx::scan<\"" + key +
+                  "={%u} name={%s}\"_fs, unsigned, std::string_view>(input); }\n";
+    }
+    return {"formats_" + std::to_string(count), source};
+}
+
+std::vector<test_case> make_cases() {
+    std::vector<test_case> cases;
+    cases.push_back({"headers", PRELUDE});
+    for (const std::size_t count : {1, 8, 32, 128}) {
+        cases.push_back(make_placeholders_case(count));
+    }
+    for (const std::size_t length : {1024, 16384, 65000}) {
+        cases.push_back(make_source_case(length));
+    }
+    for (const std::size_t count : {1, 16, 64}) {
+        cases.push_back(make_formats_case(count));
+    }
+    return cases;
+}
+
+// Компилирует файл один раз; вывод компилятора, в том числе -ftime-report, пишется в log
+bool compile_once(const options& opts, const std::filesystem::path& source, const std::filesystem::path& log,
+                  cost& result) {
+    const std::filesystem::path object = std::filesystem::path(source).replace_extension(".o");
+    std::vector<std::string> args = {opts.compiler, "-std=c++23", "-I" + opts.include};
+    args.insert(args.end(), opts.flags.begin(), opts.flags.end());
+    args.insert(args.end(), {"-c", source.string(), "-o", object.string()});
+
+    std::vector<char*> argv;
+    for (auto& arg : args) {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    const auto start = std::chrono::steady_clock::now();
+    const pid_t pid = fork();
+    if (pid < 0) {
+        std::perror("fork");
+        return false;
+    }
+    if (pid == 0) {
+        const int fd = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0) {
+            dup2(fd, STDOUT_FILENO);
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+        }
+        execvp(argv[0], argv.data());
+        std::perror("execvp");
+        _exit(127);
+    }
+
+    int status = 0;
+    rusage usage{};
+    if (wait4(pid, &status, 0, &usage) < 0) {
+        std::perror("wait4");
+        return false;
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result = {elapsed.count(), usage.ru_maxrss};
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+std::map<std::string, cost> read_baseline(const std::filesystem::path& path) {
+    std::map<std::string, cost> baseline;
+    std::ifstream in(path);
+    std::string name;
+    cost value;
+    while (in >> name) {
+        if (name.starts_with('#')) {
+            std::getline(in, name);
+            continue;
+        }
+        if (in >> value.seconds >> value.max_rss_kb) {
+            baseline[name] = value;
+        }
+    }
+    return baseline;
+}
+
+void write_baseline(const std::filesystem::path& path, const std::vector<std::pair<std::string, cost>>& results) {
+    std::ofstream out(path);
+    out << "# name seconds max_rss_kb\n";
+    for (const auto& [name, value] : results) {
+        out << name << ' ' << value.seconds << ' ' << value.max_rss_kb << '\n';
+    }
+}
+
+bool exceeds(double current, double base, double tolerance, double noise) {
+    return current > base * (1 + tolerance) && current - base > noise;
+}
+
+bool parse_options(int argc, char** argv, options& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto value = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+        if (arg == "--compiler") {
+            opts.compiler = value();
+        } else if (arg == "--include") {
+            opts.include = value();
+        } else if (arg == "--work") {
+            opts.work = value();
+        } else if (arg == "--baseline") {
+            opts.baseline = value();
+        } else if (arg == "--tolerance") {
+            opts.tolerance = std::atof(value().c_str());
+        } else if (arg == "--repeats") {
+            opts.repeats = std::max(1, std::atoi(value().c_str()));
+        } else if (arg == "--update") {
+            opts.update = true;
+        } else if (arg == "--") {
+            opts.flags.assign(argv + i + 1, argv + argc);
+            break;
+        } else {
+            std::fprintf(stderr, "unknown argument: %s\n", arg.c_str());
+            return false;
+        }
+    }
+    return !opts.compiler.empty() && !opts.include.empty() && !opts.work.empty() && !opts.baseline.empty();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    options opts;
+    if (!parse_options(argc, argv, opts)) {
+        std::fprintf(stderr, "usage: %s --compiler <path> --include <dir> --work <dir> --baseline <file> "
+                             "[--tolerance 0.25] [--repeats 3] [--update] [-- <flags>...]\n", argv[0]);
+        return 2;
+    }
+    std::filesystem::create_directories(opts.work);
+
+    const bool compare = !opts.update && std::filesystem::exists(opts.baseline);
+    const auto baseline = compare ? read_baseline(opts.baseline) : std::map<std::string, cost>{};
+
+    std::vector<std::pair<std::string, cost>> results;
+    bool regressed = false;
+    for (const auto& current : make_cases()) {
+        const auto source = opts.work / (current.name + ".cpp");
+        const auto log = opts.work / (current.name + ".log");
+        std::ofstream(source) << current.source;
+
+        cost best;
+        for (int i = 0; i < opts.repeats; ++i) {
+            cost run;
+            if (!compile_once(opts, source, log, run)) {
+                std::fprintf(stderr, "%s: compilation failed, see %s\n", current.name.c_str(), log.c_str());
+                return 1;
+            }
+            best.seconds = (i == 0) ? run.seconds : std::min(best.seconds, run.seconds);
+            best.max_rss_kb = std::max(best.max_rss_kb, run.max_rss_kb);
+        }
+        results.emplace_back(current.name, best);
+
+        std::printf("%-20s %8.3f s %10ld KB", current.name.c_str(), best.seconds, best.max_rss_kb);
+        if (const auto it = baseline.find(current.name); it != baseline.end()) {
+            const cost& base = it->second;
+            const bool slower = exceeds(best.seconds, base.seconds, opts.tolerance, TIME_NOISE_SECONDS);
+            const bool bigger = exceeds(static_cast<double>(best.max_rss_kb), static_cast<double>(base.max_rss_kb),
+                                        opts.tolerance, MEMORY_NOISE_KB);
+            std::printf("   baseline %8.3f s %10ld KB%s%s", base.seconds, base.max_rss_kb,
+                        slower ? "   TIME REGRESSION" : "", bigger ? "   MEMORY REGRESSION" : "");
+            regressed = regressed || slower || bigger;
+        }
+        std::printf("\n");
+    }
+
+    write_baseline(opts.work / "results.txt", results);
+    if (!compare) {
+        write_baseline(opts.baseline, results);
+        std::printf("baseline saved to %s\n", opts.baseline.c_str());
+    }
+    return regressed ? 1 : 0;
+}
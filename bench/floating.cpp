@@ -0,0 +1,114 @@
+#include "bench.hpp"
+#include "floating.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t FIELDS_COUNT = 1 << 20;
+
+// Генерирует записи чисел, возвращаемые make_text, в одном непрерывном буфере.
+// Каждое поле завершается нулём, чтобы strtod не читал следующее поле
+template <typename F>
+std::vector<std::string_view> make_fields(std::string& buffer, F&& make_text) {
+    std::vector<std::size_t> offsets;
+    offsets.reserve(FIELDS_COUNT + 1);
+    for (std::size_t i = 0; i < FIELDS_COUNT; ++i) {
+        offsets.push_back(buffer.size());
+        buffer += make_text();
+        buffer += '\0';
+    }
+    offsets.push_back(buffer.size());
+
+    std::vector<std::string_view> fields;
+    fields.reserve(FIELDS_COUNT);
+    for (std::size_t i = 0; i < FIELDS_COUNT; ++i) {
+        fields.emplace_back(buffer.data() + offsets[i], offsets[i + 1] - offsets[i] - 1);
+    }
+    return fields;
+}
+
+// Запись value в формате format с точностью precision, precision < 0 - кратчайшая запись
+template <typename T>
+std::string to_text(T value, std::chars_format format, int precision = -1) {
+    char text[64];
+    const auto end = precision < 0 ? std::to_chars(text, text + sizeof(text), value, format).ptr
+                                   : std::to_chars(text, text + sizeof(text), value, format, precision).ptr;
+    return std::string(text, end);
+}
+
+template <typename T, typename F>
+void compare_with_standard(std::string_view name, F&& make_text) {
+    std::string buffer;
+    const auto fields = make_fields(buffer, make_text);
+    const std::size_t bytes = buffer.size() - FIELDS_COUNT;
+
+    const auto strtod_time = bench::measure([&] {
+        double sum = 0;
+        for (const auto& field : fields) {
+            if constexpr (std::is_same_v<T, float>) {
+                sum += std::strtof(field.data(), nullptr);
+            } else {
+                sum += std::strtod(field.data(), nullptr);
+            }
+        }
+        bench::do_not_optimize(sum);
+    });
+    const auto from_chars_time = bench::measure([&] {
+        double sum = 0;
+        for (const auto& field : fields) {
+            T value{};
+            std::from_chars(field.data(), field.data() + field.size(), value);
+            sum += value;
+        }
+        bench::do_not_optimize(sum);
+    });
+    const auto kernel_time = bench::measure([&] {
+        double sum = 0;
+        for (const auto& field : fields) {
+            sum += stdx::details::parse_float<T>(field).value_or(0);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    const char* strtod_name = std::is_same_v<T, float> ? " / strtof" : " / strtod";
+    bench::report("floating", std::string(name) + strtod_name, strtod_time, bytes, FIELDS_COUNT);
+    bench::report("floating", std::string(name) + " / std::from_chars", from_chars_time, bytes, FIELDS_COUNT);
+    bench::report("floating", std::string(name) + " / parse_float", kernel_time, bytes, FIELDS_COUNT);
+}
+
+} // namespace
+
+void bench::run_floating_benchmarks() {
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> price(0, 100000);
+    std::uniform_real_distribution<float> latency(0, 1);
+    std::uniform_real_distribution<double> coordinate(-180, 180);
+    std::uniform_int_distribution<int> exponent(-300, 300);
+
+    // Цены с двумя знаками после запятой: быстрый путь с точными степенями десяти
+    compare_with_standard<double>("double prices 12345.67", [&] {
+        return to_text(price(gen), std::chars_format::fixed, 2);
+    });
+    // Задержки в секундах: кратчайшая запись float
+    compare_with_standard<float>("float latencies 0.0123456", [&] {
+        return to_text(latency(gen), std::chars_format::general);
+    });
+    // Координаты: кратчайшая запись double, до 17 значащих цифр
+    compare_with_standard<double>("double coordinates shortest", [&] {
+        return to_text(coordinate(gen), std::chars_format::general);
+    });
+    // Широкий диапазон порядков: алгоритм Эйзеля-Лемира
+    compare_with_standard<double>("double scientific 1e-300..1e300", [&] {
+        return to_text(coordinate(gen) * std::pow(10.0, exponent(gen)), std::chars_format::scientific);
+    });
+    // Больше 19 значащих цифр: проверка усечения мантиссы
+    compare_with_standard<double>("double 25 significant digits", [&] {
+        return to_text(coordinate(gen), std::chars_format::scientific, 24);
+    });
+}
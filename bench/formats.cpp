@@ -0,0 +1,682 @@
+#include "address.hpp"
+#include "arena.hpp"
+#include "bench.hpp"
+#include "file.hpp"
+#include "format_string.hpp"
+#include "instrument.hpp"
+#include "keyword.hpp"
+#include "lazy.hpp"
+#include "match.hpp"
+#include "record.hpp"
+#include "scan.hpp"
+#include "timestamp.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <random>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <arpa/inet.h>
+
+namespace {
+
+using namespace stdx::details::literals;
+
+constexpr std::size_t DATA_SIZE = 4 << 20;
+
+// Синтетический набор строк одного формата
+struct dataset {
+    std::string data;
+    std::size_t lines = 0;
+};
+
+template <typename F>
+dataset make_dataset(F&& make_line) {
+    std::mt19937_64 gen(42);
+    dataset result;
+    result.data.reserve(DATA_SIZE + 1024);
+    while (result.data.size() < DATA_SIZE) {
+        result.data += make_line(gen);
+        result.data += '\n';
+        ++result.lines;
+    }
+    return result;
+}
+
+// Прогоняет разбор parse_line(line) -> bool по всем строкам набора и печатает результат
+template <typename F>
+void run_case(std::string_view format_name, std::string_view parser_name, const dataset& set, F&& parse_line,
+              int repeats = 5) {
+    std::size_t parsed = 0;
+    const auto result = bench::measure([&] {
+        parsed = 0;
+        stdx::details::for_each_line(set.data, [&](std::string_view line) { parsed += parse_line(line) ? 1 : 0; });
+        bench::do_not_optimize(parsed);
+    }, repeats);
+
+    bench::report("formats", std::string(format_name) + " / " + std::string(parser_name), result, set.data.size(),
+                  set.lines);
+    if (parsed != set.lines) {
+        std::printf("           warning: %zu of %zu lines parsed\n", parsed, set.lines);
+    }
+}
+
+// Прогоняет проверку всего буфера match_all(buffer) -> число подходящих строк и печатает результат
+template <typename F>
+void run_buffer_case(std::string_view format_name, std::string_view parser_name, const dataset& set, F&& match_all) {
+    std::size_t matched = 0;
+    const auto result = bench::measure([&] {
+        matched = match_all(std::string_view(set.data));
+        bench::do_not_optimize(matched);
+    });
+
+    bench::report("formats", std::string(format_name) + " / " + std::string(parser_name), result, set.data.size(),
+                  set.lines);
+    if (matched != set.lines) {
+        std::printf("           warning: %zu of %zu lines matched\n", matched, set.lines);
+    }
+}
+
+// Курсор для рукописных разборщиков на std::string_view::find и std::from_chars
+struct cursor {
+    std::string_view line;
+    std::size_t pos = 0;
+
+    bool literal(std::string_view expected) {
+        if (line.substr(pos, expected.size()) != expected) {
+            return false;
+        }
+        pos += expected.size();
+        return true;
+    }
+
+    bool until(std::string_view separator, std::string_view& out) {
+        const std::size_t end = separator.empty() ? line.size() : line.find(separator, pos);
+        if (end == std::string_view::npos) {
+            return false;
+        }
+        out = line.substr(pos, end - pos);
+        pos = end + separator.size();
+        return true;
+    }
+
+    template <typename T>
+    bool number(std::string_view separator, T& out) {
+        std::string_view field;
+        if (!until(separator, field)) {
+            return false;
+        }
+        const auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), out);
+        return ec == std::errc{} && ptr == field.data() + field.size();
+    }
+};
+
+template <typename T>
+bool regex_number(const std::csub_match& match, T& out) {
+    const auto [ptr, ec] = std::from_chars(match.first, match.second, out);
+    return ec == std::errc{} && ptr == match.second;
+}
+
+// sscanf вызывает strlen для всего остатка буфера, поэтому строка копируется в собственный буфер
+struct c_line {
+    char data[4096];
+
+    explicit c_line(std::string_view line) {
+        const std::size_t size = std::min(line.size(), sizeof(data) - 1);
+        std::memcpy(data, line.data(), size);
+        data[size] = '\0';
+    }
+};
+
+bool regex_line(std::string_view line, const std::regex& re, std::cmatch& match) {
+    return std::regex_match(line.data(), line.data() + line.size(), match, re);
+}
+
+// ===== Журнал веб-сервера =====
+struct access_record {
+    std::string_view ip;
+    std::string_view date;
+    std::string_view method;
+    std::string_view path;
+    std::string_view protocol;
+    std::uint16_t status = 0;
+    std::uint64_t bytes = 0;
+};
+
+void bench_access_log() {
+    const auto set = make_dataset([](auto& gen) {
+        constexpr const char* methods[] = {"GET", "POST", "PUT", "DELETE"};
+        return "10.0." + std::to_string(gen() % 256) + "." + std::to_string(gen() % 256) + " - - [10/Oct/2000:13:" +
+               std::to_string(10 + gen() % 50) + ":36 -0700] \"" + methods[gen() % 4] + " /api/v1/items/" +
+               std::to_string(gen() % 100000) + " HTTP/1.1\" " + std::to_string(200 + gen() % 300) + " " +
+               std::to_string(gen() % 1000000);
+    });
+
+    run_case("access-log", "stdx::scan", set, [](std::string_view line) {
+        const auto result = stdx::scan<"{%s} - - [{%s}] \"{%s} {%s} {%s}\" {%u} {%u}"_fs, std::string_view,
+                                       std::string_view, std::string_view, std::string_view, std::string_view,
+                                       std::uint16_t, std::uint64_t>(line);
+        bench::do_not_optimize(result);
+        return result.has_value();
+    });
+
+    // Стоимость счётчиков формата и выборочного замера тактов по сравнению с разбором без политики
+    run_case("access-log", "stdx::scan, instrumented", set, [](std::string_view line) {
+        const auto result = stdx::scan<"{%s} - - [{%s}] \"{%s} {%s} {%s}\" {%u} {%u}"_fs, stdx::instrumented<>,
+                                       std::string_view, std::string_view, std::string_view, std::string_view,
+                                       std::string_view, std::uint16_t, std::uint64_t>(line);
+        bench::do_not_optimize(result);
+        return result.has_value();
+    });
+
+    run_case("access-log", "stdx::scan, instrumented<64>", set, [](std::string_view line) {
+        const auto result = stdx::scan<"{%s} - - [{%s}] \"{%s} {%s} {%s}\" {%u} {%u}"_fs, stdx::instrumented<64>,
+                                       std::string_view, std::string_view, std::string_view, std::string_view,
+                                       std::string_view, std::uint16_t, std::uint64_t>(line);
+        bench::do_not_optimize(result);
+        return result.has_value();
+    });
+
+    // Заполнение массива записей: копирование из scan_result против разбора прямо в запись
+    std::vector<access_record> records(set.lines);
+    std::size_t index = 0;
+    run_case("access-log", "stdx::scan + copy", set, [&](std::string_view line) {
+        const auto result = stdx::scan<"{%s} - - [{%s}] \"{%s} {%s} {%s}\" {%u} {%u}"_fs, std::string_view,
+                                       std::string_view, std::string_view, std::string_view, std::string_view,
+                                       std::uint16_t, std::uint64_t>(line);
+        if (!result) {
+            return false;
+        }
+        auto& record = records[index++ % records.size()];
+        std::tie(record.ip, record.date, record.method, record.path, record.protocol, record.status, record.bytes) =
+            result->values();
+        return true;
+    });
+    bench::do_not_optimize(records.data());
+
+    run_case("access-log", "stdx::scan_into", set, [&](std::string_view line) {
+        return stdx::scan_into<"{%s} - - [{%s}] \"{%s} {%s} {%s}\" {%u} {%u}"_fs>(line,
+                                                                                records[index++ % records.size()])
+            .has_value();
+    });
+    bench::do_not_optimize(records.data());
+
+    // Записи, переживающие входной буфер: копии полей в std::string против арены, сбрасываемой каждые 1024 строки
+    struct owned_record {
+        std::string ip, date, method, path, protocol;
+        std::uint16_t status = 0;
+        std::uint64_t bytes = 0;
+    };
+    std::vector<owned_record> owned(1024);
+    run_case("access-log", "stdx::scan + std::string", set, [&](std::string_view line) {
+        const auto result = stdx::scan<"{%s} - - [{%s}] \"{%s} {%s} {%s}\" {%u} {%u}"_fs, std::string_view,
+                                       std::string_view, std::string_view, std::string_view, std::string_view,
+                                       std::uint16_t, std::uint64_t>(line);
+        if (!result) {
+            return false;
+        }
+        // Новая запись на каждую строку, как при передаче записей дальше по конвейеру
+        owned_record record;
+        std::tie(record.ip, record.date, record.method, record.path, record.protocol, record.status, record.bytes) =
+            result->values();
+        owned[index++ % owned.size()] = std::move(record);
+        return true;
+    });
+    bench::do_not_optimize(owned.data());
+
+    stdx::scan_arena arena;
+    const auto run_arena_case = [&]<typename Intern>(std::string_view name, Intern) {
+        std::size_t batch = 0;
+        run_case("access-log", name, set, [&](std::string_view line) {
+            if (++batch % 1024 == 0) {
+                arena.reset();
+            }
+            const auto result = stdx::scan_owned<"{%s} - - [{%s}] \"{%s} {%s} {%s}\" {%u} {%u}"_fs, Intern,
+                                                 std::string_view, std::string_view, std::string_view,
+                                                 std::string_view, std::string_view, std::uint16_t, std::uint64_t>(
+                line, arena);
+            bench::do_not_optimize(result);
+            return result.has_value();
+        });
+    };
+    run_arena_case("stdx::scan_owned", stdx::intern<>{});
+    run_arena_case("stdx::scan_owned, interned method", stdx::intern<2, 4>{});
+
+    run_case("access-log", "sscanf", set, [](std::string_view line) {
+        char ip[16], date[32], method[8], path[256], protocol[16];
+        unsigned short status = 0;
+        unsigned long bytes = 0;
+        const int fields = std::sscanf(c_line(line).data, "%15s - - [%31[^]]] \"%7s %255s %15[^\"]\" %hu %lu", ip, date,
+                                       method, path, protocol, &status, &bytes);
+        bench::do_not_optimize(bytes);
+        return fields == 7;
+    });
+
+    run_case("access-log", "from_chars", set, [](std::string_view line) {
+        cursor in{line};
+        std::string_view ip, date, method, path, protocol;
+        std::uint16_t status = 0;
+        std::uint64_t bytes = 0;
+        const bool ok = in.until(" - - [", ip) && in.until("] \"", date) && in.until(" ", method) &&
+                        in.until(" ", path) && in.until("\" ", protocol) && in.number(" ", status) &&
+                        in.number("", bytes);
+        bench::do_not_optimize(bytes);
+        return ok;
+    });
+
+    const std::regex re(R"re((\S+) - - \[([^\]]+)\] "(\S+) (\S+) ([^"]+)" (\d+) (\d+))re");
+    run_case("access-log", "std::regex", set, [&](std::string_view line) {
+        std::cmatch match;
+        std::uint16_t status = 0;
+        std::uint64_t bytes = 0;
+        const bool ok = regex_line(line, re, match) && regex_number(match[6], status) && regex_number(match[7], bytes);
+        bench::do_not_optimize(bytes);
+        return ok;
+    }, 1);
+}
+
+// ===== Пары ключ=значение =====
+enum class log_level { debug, info, warn, error };
+
+} // namespace
+
+template <>
+struct stdx::keywords<log_level> {
+    static constexpr std::array entries = {
+        stdx::keyword{"debug", log_level::debug}, stdx::keyword{"info", log_level::info},
+        stdx::keyword{"warn", log_level::warn}, stdx::keyword{"error", log_level::error}};
+};
+
+namespace {
+
+void bench_key_value() {
+    const auto set = make_dataset([](auto& gen) {
+        constexpr const char* levels[] = {"debug", "info", "warn", "error"};
+        return "ts=" + std::to_string(1700000000000 + gen() % 100000000) + " level=" + levels[gen() % 4] +
+               " user=user" + std::to_string(gen() % 10000) + " latency_us=" + std::to_string(gen() % 100000);
+    });
+
+    run_case("key=value", "stdx::scan", set, [](std::string_view line) {
+        const auto result = stdx::scan<"ts={%u} level={%s} user={%s} latency_us={%u}"_fs, std::uint64_t,
+                                       std::string_view, std::string_view, std::uint32_t>(line);
+        bench::do_not_optimize(result);
+        return result.has_value();
+    });
+
+    // Уровень сравнивается со строками после разбора против разбора ключевого слова по совершенному хешу
+    run_case("key=value", "stdx::scan + compare", set, [](std::string_view line) {
+        const auto result = stdx::scan<"ts={%u} level={%s} user={%s} latency_us={%u}"_fs, std::uint64_t,
+                                       std::string_view, std::string_view, std::uint32_t>(line);
+        if (!result) {
+            return false;
+        }
+        const std::string_view level = std::get<1>(result->values());
+        const log_level value = level == "debug" ? log_level::debug
+                                : level == "info" ? log_level::info
+                                : level == "warn" ? log_level::warn
+                                                  : log_level::error;
+        bench::do_not_optimize(value);
+        return level == "error" || value != log_level::error;
+    });
+
+    run_case("key=value", "stdx::scan %k", set, [](std::string_view line) {
+        const auto result = stdx::scan<"ts={%u} level={%k} user={%s} latency_us={%u}"_fs, std::uint64_t, log_level,
+                                       std::string_view, std::uint32_t>(line);
+        bench::do_not_optimize(result);
+        return result.has_value();
+    });
+
+    run_case("key=value", "sscanf", set, [](std::string_view line) {
+        unsigned long ts = 0;
+        char level[16], user[32];
+        unsigned latency = 0;
+        const int fields = std::sscanf(c_line(line).data, "ts=%lu level=%15s user=%31s latency_us=%u", &ts, level, user,
+                                       &latency);
+        bench::do_not_optimize(latency);
+        return fields == 4;
+    });
+
+    run_case("key=value", "from_chars", set, [](std::string_view line) {
+        cursor in{line};
+        std::uint64_t ts = 0;
+        std::string_view level, user;
+        std::uint32_t latency = 0;
+        const bool ok = in.literal("ts=") && in.number(" level=", ts) && in.until(" user=", level) &&
+                        in.until(" latency_us=", user) && in.number("", latency);
+        bench::do_not_optimize(latency);
+        return ok;
+    });
+
+    const std::regex re(R"re(ts=(\d+) level=(\S+) user=(\S+) latency_us=(\d+))re");
+    run_case("key=value", "std::regex", set, [&](std::string_view line) {
+        std::cmatch match;
+        std::uint64_t ts = 0;
+        std::uint32_t latency = 0;
+        const bool ok = regex_line(line, re, match) && regex_number(match[1], ts) && regex_number(match[4], latency);
+        bench::do_not_optimize(latency);
+        return ok;
+    }, 1);
+}
+
+// ===== Значения через запятую =====
+void bench_csv() {
+    const auto set = make_dataset([](auto& gen) {
+        return "item" + std::to_string(gen() % 100000) + "," + std::to_string(gen() % 1000) + "," +
+               std::to_string(static_cast<int>(gen() % 2000) - 1000) + ",warehouse-" + std::to_string(gen() % 64);
+    });
+
+    run_case("csv", "stdx::scan", set, [](std::string_view line) {
+        const auto result =
+            stdx::scan<"{%s},{%u},{%d},{%s}"_fs, std::string_view, std::uint32_t, std::int32_t, std::string_view>(
+                line);
+        bench::do_not_optimize(result);
+        return result.has_value();
+    });
+
+    run_case("csv", "sscanf", set, [](std::string_view line) {
+        char item[32], location[32];
+        unsigned quantity = 0;
+        int delta = 0;
+        const int fields = std::sscanf(c_line(line).data, "%31[^,],%u,%d,%31s", item, &quantity, &delta, location);
+        bench::do_not_optimize(delta);
+        return fields == 4;
+    });
+
+    run_case("csv", "from_chars", set, [](std::string_view line) {
+        cursor in{line};
+        std::string_view item, location;
+        std::uint32_t quantity = 0;
+        std::int32_t delta = 0;
+        const bool ok = in.until(",", item) && in.number(",", quantity) && in.number(",", delta) &&
+                        in.until("", location);
+        bench::do_not_optimize(delta);
+        return ok;
+    });
+
+    const std::regex re(R"re(([^,]+),(\d+),(-?\d+),(.+))re");
+    run_case("csv", "std::regex", set, [&](std::string_view line) {
+        std::cmatch match;
+        std::uint32_t quantity = 0;
+        std::int32_t delta = 0;
+        const bool ok = regex_line(line, re, match) && regex_number(match[2], quantity) && regex_number(match[3], delta);
+        bench::do_not_optimize(delta);
+        return ok;
+    }, 1);
+}
+
+// ===== Метка времени ISO-8601 и адрес клиента =====
+using sys_us = std::chrono::sys_time<std::chrono::microseconds>;
+
+void bench_typed_log() {
+    const auto set = make_dataset([](auto& gen) {
+        char time[40];
+        std::snprintf(time, sizeof(time), "2024-%02u-%02uT%02u:%02u:%02u.%06uZ", static_cast<unsigned>(1 + gen() % 12),
+                      static_cast<unsigned>(1 + gen() % 28), static_cast<unsigned>(gen() % 24),
+                      static_cast<unsigned>(gen() % 60), static_cast<unsigned>(gen() % 60),
+                      static_cast<unsigned>(gen() % 1000000));
+        return std::string(time) + " 10." + std::to_string(gen() % 256) + "." + std::to_string(gen() % 256) + "." +
+               std::to_string(gen() % 256) + " /api/v" + std::to_string(gen() % 4) + " " + std::to_string(gen() % 100000);
+    });
+
+    run_case("timestamp + ipv4", "stdx::scan, {%T} {%I}", set, [](std::string_view line) {
+        const auto result =
+            stdx::scan<"{%T} {%I} {%s} {%u}"_fs, sys_us, stdx::ipv4_address, std::string_view, std::uint32_t>(line);
+        bench::do_not_optimize(result);
+        return result.has_value();
+    });
+
+    // Второй проход по строковым полям: так разбирают метку времени и адрес без stdx::scanner
+    run_case("timestamp + ipv4", "stdx::scan {%s} + inet_pton", set, [](std::string_view line) {
+        const auto result =
+            stdx::scan<"{%s} {%s} {%s} {%u}"_fs, std::string_view, std::string_view, std::string_view, std::uint32_t>(
+                line);
+        if (!result) {
+            return false;
+        }
+        const auto [time, ip, path, latency] = result->values();
+        const auto parsed_time = stdx::details::parse_timestamp<std::chrono::microseconds>(time);
+        in_addr parsed_ip{};
+        const bool ok = parsed_time && ip.size() < INET_ADDRSTRLEN &&
+                        inet_pton(AF_INET, std::string(ip).c_str(), &parsed_ip) == 1;
+        bench::do_not_optimize(parsed_ip);
+        bench::do_not_optimize(parsed_time);
+        return ok;
+    });
+
+    run_case("timestamp + ipv4", "sscanf + timegm + inet_pton", set, [](std::string_view line) {
+        std::tm tm{};
+        unsigned micros = 0, latency = 0;
+        char ip[INET_ADDRSTRLEN], path[64];
+        const int fields = std::sscanf(c_line(line).data, "%d-%d-%dT%d:%d:%d.%uZ %15s %63s %u", &tm.tm_year,
+                                       &tm.tm_mon, &tm.tm_mday, &tm.tm_hour, &tm.tm_min, &tm.tm_sec, &micros, ip, path,
+                                       &latency);
+        tm.tm_year -= 1900;
+        tm.tm_mon -= 1;
+        const auto seconds = timegm(&tm);
+        in_addr parsed_ip{};
+        const bool ok = fields == 10 && inet_pton(AF_INET, ip, &parsed_ip) == 1;
+        bench::do_not_optimize(seconds);
+        bench::do_not_optimize(parsed_ip);
+        return ok;
+    });
+}
+
+// ===== N беззнаковых полей через запятую =====
+template <std::size_t N>
+consteval auto make_fields_format() {
+    char text[N * 5] = {};
+    for (std::size_t i = 0; i < N; ++i) {
+        text[i * 5 + 0] = '{';
+        text[i * 5 + 1] = '%';
+        text[i * 5 + 2] = 'u';
+        text[i * 5 + 3] = '}';
+        text[i * 5 + 4] = (i + 1 < N) ? ',' : '\0';
+    }
+    return stdx::details::fixed_string<N * 5>(text);
+}
+
+template <std::size_t I>
+using field_type = std::uint32_t;
+
+template <std::size_t N>
+void bench_fields() {
+    const auto set = make_dataset([](auto& gen) {
+        std::string line;
+        for (std::size_t i = 0; i < N; ++i) {
+            line += (i == 0 ? "" : ",") + std::to_string(gen() % 1000000);
+        }
+        return line;
+    });
+    const std::string name = std::to_string(N) + " fields";
+
+    run_case(name, "stdx::scan", set, [](std::string_view line) {
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            const auto result =
+                stdx::scan<stdx::details::format_string<make_fields_format<N>()>{}, field_type<Is>...>(line);
+            bench::do_not_optimize(result);
+            return result.has_value();
+        }(std::make_index_sequence<N>{});
+    });
+
+    std::string scanf_format;
+    for (std::size_t i = 0; i < N; ++i) {
+        scanf_format += (i == 0) ? "%u" : ",%u";
+    }
+    run_case(name, "sscanf", set, [&](std::string_view line) {
+        unsigned values[N] = {};
+        const int fields = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return std::sscanf(c_line(line).data, scanf_format.c_str(), &values[Is]...);
+        }(std::make_index_sequence<N>{});
+        bench::do_not_optimize(values);
+        return fields == static_cast<int>(N);
+    });
+
+    run_case(name, "from_chars", set, [](std::string_view line) {
+        cursor in{line};
+        std::uint32_t values[N] = {};
+        bool ok = true;
+        for (std::size_t i = 0; ok && i < N; ++i) {
+            ok = in.number(i + 1 < N ? "," : "", values[i]);
+        }
+        bench::do_not_optimize(values);
+        return ok;
+    });
+
+    std::string pattern;
+    for (std::size_t i = 0; i < N; ++i) {
+        pattern += (i == 0) ? "(\\d+)" : ",(\\d+)";
+    }
+    const std::regex re(pattern);
+    run_case(name, "std::regex", set, [&](std::string_view line) {
+        std::cmatch match;
+        std::uint32_t values[N] = {};
+        bool ok = regex_line(line, re, match);
+        for (std::size_t i = 0; ok && i < N; ++i) {
+            ok = regex_number(match[i + 1], values[i]);
+        }
+        bench::do_not_optimize(values);
+        return ok;
+    }, 1);
+}
+
+// Записи фиксированной длины: поля с шириной против тех же полей, ограниченных литералами
+void bench_fixed_width() {
+    const auto set = make_dataset([](auto& gen) {
+        char line[64];
+        const auto date = static_cast<unsigned>(20000101 + gen() % 300000);
+        const auto account = static_cast<unsigned long long>(gen() % 10000000000);
+        const auto amount = static_cast<unsigned long long>(gen() % 1000000000000);
+        std::snprintf(line, sizeof(line), "%08u %010llu %012llu %-6s", date, account, amount,
+                      (gen() % 2) ? "DEBIT" : "CREDIT");
+        return std::string(line);
+    });
+
+    run_case("fixed-width", "stdx::scan %N", set, [](std::string_view line) {
+        const auto result = stdx::scan<"{%8u} {%10u} {%12u} {%6s}"_fs, std::uint32_t, std::uint64_t, std::uint64_t,
+                                       std::string_view>(line);
+        bench::do_not_optimize(result);
+        return result.has_value();
+    });
+
+    run_case("fixed-width", "stdx::scan", set, [](std::string_view line) {
+        const auto result =
+            stdx::scan<"{%u} {%u} {%u} {%s}"_fs, std::uint32_t, std::uint64_t, std::uint64_t, std::string_view>(line);
+        bench::do_not_optimize(result);
+        return result.has_value();
+    });
+
+    run_case("fixed-width", "from_chars", set, [](std::string_view line) {
+        cursor in{line};
+        std::uint32_t date = 0;
+        std::uint64_t account = 0, amount = 0;
+        std::string_view kind;
+        const bool ok = in.number(" ", date) && in.number(" ", account) && in.number(" ", amount) && in.until("", kind);
+        bench::do_not_optimize(amount);
+        return ok;
+    });
+}
+
+// ===== Проверка строк без разбора: stdx::match против scan с отбрасыванием значений =====
+void bench_match() {
+    const auto access = make_dataset([](auto& gen) {
+        return "10.0." + std::to_string(gen() % 256) + "." + std::to_string(gen() % 256) + " - - [10/Oct/2000:13:55:36 -0700] \"GET /api/v1/items/" +
+               std::to_string(gen() % 100000) + " HTTP/1.1\" " + std::to_string(200 + gen() % 300) + " " +
+               std::to_string(gen() % 1000000);
+    });
+    run_case("access-log", "stdx::scan, validate only", access, [](std::string_view line) {
+        return stdx::scan<"{%s} - - [{%s}] \"{%s} {%s} {%s}\" {%u} {%u}"_fs, std::string_view, std::string_view,
+                          std::string_view, std::string_view, std::string_view, std::uint16_t, std::uint64_t>(line)
+            .has_value();
+    });
+    run_buffer_case("access-log", "stdx::match", access, [](std::string_view buffer) {
+        return stdx::match<"{%s} - - [{%s}] \"{%s} {%s} {%s}\" {%u} {%u}"_fs>(buffer).count();
+    });
+
+    // Короткие записи фиксированной длины: несколько записей за один шаг SIMD
+    const auto readings = make_dataset([](auto& gen) {
+        char line[16];
+        std::snprintf(line, sizeof(line), "%02u:%02u %03u", static_cast<unsigned>(gen() % 24),
+                      static_cast<unsigned>(gen() % 60), static_cast<unsigned>(gen() % 1000));
+        return std::string(line);
+    });
+    run_case("short fixed records", "stdx::scan, validate only", readings, [](std::string_view line) {
+        return stdx::scan<"{%2u}:{%2u} {%3u}"_fs, std::uint8_t, std::uint8_t, std::uint16_t>(line).has_value();
+    });
+    run_case("short fixed records", "match_line", readings, [](std::string_view line) {
+        return stdx::details::match_line<"{%2u}:{%2u} {%3u}"_fs>(line);
+    });
+    run_buffer_case("short fixed records", "stdx::match", readings, [](std::string_view buffer) {
+        return stdx::match<"{%2u}:{%2u} {%3u}"_fs>(buffer).count();
+    });
+}
+
+// ===== Ленивый разбор: из N полей читаются только первые K =====
+template <std::size_t N, std::size_t K>
+void bench_lazy_case(const dataset& set) {
+    run_case(std::to_string(N) + " fields, read " + std::to_string(K), "stdx::scan_lazy", set,
+             [](std::string_view line) {
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            auto result =
+                stdx::scan_lazy<stdx::details::format_string<make_fields_format<N>()>{}, field_type<Is>...>(line);
+            if (!result) {
+                return false;
+            }
+            return [&]<std::size_t... Ks>(std::index_sequence<Ks...>) {
+                std::uint32_t sum = 0;
+                const bool ok = ([&] {
+                    const auto value = result->template get<Ks>();
+                    sum += value.value_or(0);
+                    return value.has_value();
+                }() && ...);
+                bench::do_not_optimize(sum);
+                return ok;
+            }(std::make_index_sequence<K>{});
+        }(std::make_index_sequence<N>{});
+    });
+}
+
+template <std::size_t N>
+void bench_lazy() {
+    const auto set = make_dataset([](auto& gen) {
+        std::string line;
+        for (std::size_t i = 0; i < N; ++i) {
+            line += (i == 0 ? "" : ",") + std::to_string(gen() % 1000000);
+        }
+        return line;
+    });
+
+    run_case(std::to_string(N) + " fields, read all", "stdx::scan", set, [](std::string_view line) {
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            const auto result =
+                stdx::scan<stdx::details::format_string<make_fields_format<N>()>{}, field_type<Is>...>(line);
+            bench::do_not_optimize(result);
+            return result.has_value();
+        }(std::make_index_sequence<N>{});
+    });
+    bench_lazy_case<N, 1>(set);
+    bench_lazy_case<N, 2>(set);
+    bench_lazy_case<N, N>(set);
+}
+
+} // namespace
+
+void bench::run_formats_benchmarks() {
+    bench_access_log();
+    bench_key_value();
+    bench_csv();
+    bench_typed_log();
+    bench_fixed_width();
+    bench_match();
+    bench_fields<1>();
+    bench_fields<4>();
+    bench_fields<16>();
+    bench_fields<64>();
+    bench_lazy<15>();
+}
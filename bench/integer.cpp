@@ -0,0 +1,124 @@
+#include "bench.hpp"
+#include "integer.hpp"
+#include "radix.hpp"
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t FIELDS_COUNT = 1 << 20;
+
+// Генерирует числовые поля со значениями до max_value в одном непрерывном буфере,
+// hex_digits != 0 - шестнадцатеричные поля ровно из hex_digits цифр
+std::vector<std::string_view> make_fields(std::string& buffer, std::uint64_t max_value, std::size_t hex_digits = 0) {
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<std::uint64_t> value(0, max_value);
+
+    std::vector<std::size_t> offsets;
+    offsets.reserve(FIELDS_COUNT + 1);
+    for (std::size_t i = 0; i < FIELDS_COUNT; ++i) {
+        offsets.push_back(buffer.size());
+        if (hex_digits == 0) {
+            buffer += std::to_string(value(gen));
+        }
+        for (std::size_t digit = 0; digit < hex_digits; ++digit) {
+            buffer += "0123456789abcdef"[gen() % 16];
+        }
+    }
+    offsets.push_back(buffer.size());
+
+    std::vector<std::string_view> fields;
+    fields.reserve(FIELDS_COUNT);
+    for (std::size_t i = 0; i < FIELDS_COUNT; ++i) {
+        fields.emplace_back(buffer.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+    return fields;
+}
+
+template <typename T>
+void compare_with_from_chars(std::string_view name, std::uint64_t max_value) {
+    std::string buffer;
+    const auto fields = make_fields(buffer, max_value);
+    const std::size_t bytes = buffer.size();
+
+    const auto from_chars_time = bench::measure([&] {
+        std::uint64_t sum = 0;
+        for (const auto& field : fields) {
+            T value{};
+            std::from_chars(field.data(), field.data() + field.size(), value);
+            sum += value;
+        }
+        bench::do_not_optimize(sum);
+    });
+    const auto kernel_time = bench::measure([&] {
+        std::uint64_t sum = 0;
+        for (const auto& field : fields) {
+            sum += stdx::details::parse_integer<T>(field).value_or(0);
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::report("integer", std::string(name) + " / std::from_chars", from_chars_time, bytes);
+    bench::report("integer", std::string(name) + " / parse_integer", kernel_time, bytes);
+}
+
+// Шестнадцатеричные идентификаторы: 64-битные span id и 128-битные trace id
+void compare_hex_with_from_chars() {
+    std::string buffer;
+    const auto spans = make_fields(buffer, 0, 16);
+    const auto from_chars_time = bench::measure([&] {
+        std::uint64_t sum = 0;
+        for (const auto& field : spans) {
+            std::uint64_t value = 0;
+            std::from_chars(field.data(), field.data() + field.size(), value, 16);
+            sum += value;
+        }
+        bench::do_not_optimize(sum);
+    });
+    const auto kernel_time = bench::measure([&] {
+        std::uint64_t sum = 0;
+        for (const auto& field : spans) {
+            sum += stdx::details::parse_radix_integer<std::uint64_t, 16>(field).value_or(0);
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::report("integer", "hex uint64_t 16 digits / std::from_chars", from_chars_time, buffer.size());
+    bench::report("integer", "hex uint64_t 16 digits / parse_radix_integer", kernel_time, buffer.size());
+
+    std::string trace_buffer;
+    const auto traces = make_fields(trace_buffer, 0, 32);
+    const auto halves_time = bench::measure([&] {
+        std::uint64_t sum = 0;
+        for (const auto& field : traces) {
+            std::uint64_t high = 0, low = 0;
+            std::from_chars(field.data(), field.data() + 16, high, 16);
+            std::from_chars(field.data() + 16, field.data() + 32, low, 16);
+            sum += high ^ low;
+        }
+        bench::do_not_optimize(sum);
+    });
+    const auto bytes_time = bench::measure([&] {
+        std::uint64_t sum = 0;
+        for (const auto& field : traces) {
+            const auto id = stdx::details::parse_hex_bytes<std::array<std::uint8_t, 16>>(field);
+            sum += id ? (*id)[0] ^ (*id)[15] : 0;
+        }
+        bench::do_not_optimize(sum);
+    });
+    bench::report("integer", "hex trace id 32 digits / 2 x std::from_chars", halves_time, trace_buffer.size());
+    bench::report("integer", "hex trace id 32 digits / parse_hex_bytes", bytes_time, trace_buffer.size());
+}
+
+} // namespace
+
+void bench::run_integer_benchmarks() {
+    compare_with_from_chars<std::uint16_t>("uint16_t status codes", 999);
+    compare_with_from_chars<std::uint32_t>("uint32_t byte counts", 4294967295u);
+    compare_with_from_chars<std::uint64_t>("uint64_t timestamps", 1ULL << 62);
+    compare_with_from_chars<std::int64_t>("int64_t 19 digits", 9223372036854775807ULL);
+    compare_hex_with_from_chars();
+}
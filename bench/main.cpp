@@ -0,0 +1,28 @@
+#include "bench.hpp"
+#include <cstring>
+
+// Запуск: scan_bench [suite...], без аргументов выполняются все наборы
+int main(int argc, char** argv) {
+    struct suite {
+        const char* name;
+        void (*run)();
+    };
+    constexpr suite suites[] = {
+        {"search", bench::run_search_benchmarks},
+        {"integer", bench::run_integer_benchmarks},
+        {"floating", bench::run_floating_benchmarks},
+        {"parallel", bench::run_parallel_benchmarks},
+        {"formats", bench::run_formats_benchmarks},
+    };
+
+    for (const auto& current : suites) {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; ++i) {
+            selected = selected || std::strcmp(argv[i], current.name) == 0;
+        }
+        if (selected) {
+            current.run();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "bench.hpp"
+#include "format_string.hpp"
+#include "parallel.hpp"
+#include "stream.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+using namespace stdx::details::literals;
+
+constexpr std::size_t DATA_SIZE = 64 << 20;
+
+// Генерирует строки журнала вида "<ip> <method> <path> <status> <bytes>"
+std::string make_log() {
+    std::mt19937_64 gen(42);
+    constexpr std::string_view methods[] = {"GET", "POST", "PUT", "DELETE"};
+
+    std::string data;
+    data.reserve(DATA_SIZE + 128);
+    while (data.size() < DATA_SIZE) {
+        data += "10.0." + std::to_string(gen() % 256) + "." + std::to_string(gen() % 256) + " ";
+        data += methods[gen() % 4];
+        data += " /api/v1/items/" + std::to_string(gen() % 100000) + " ";
+        data += std::to_string(200 + gen() % 300) + " " + std::to_string(gen() % 1000000) + "\n";
+    }
+    return data;
+}
+
+// Чтение файла с разбором: блокирующий цикл read + stream_scanner против чтения впрок в фоновом потоке.
+// Файл находится в страничном кеше, поэтому чтение сводится к копированию из ядра
+void bench_read_ahead(const std::string& data) {
+    const auto path = std::filesystem::temp_directory_path() / "scan_bench_stream.log";
+    std::ofstream(path, std::ios::binary) << data;
+
+    constexpr std::size_t buffer_size = std::size_t{1} << 20;
+    const auto blocking_time = bench::measure([&] {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        std::vector<char> buffer(buffer_size);
+        std::uint64_t total = 0;
+        stdx::stream_scanner<"{%s} {%s} {%s} {%u} {%u}"_fs, std::string_view, std::string_view, std::string_view,
+                             std::uint16_t, std::uint64_t> scanner;
+        const auto on_record = [&](const auto& record) { total += std::get<4>(record.values()); };
+        for (ssize_t size; (size = ::read(fd, buffer.data(), buffer.size())) > 0;) {
+            scanner.feed(std::span<const char>(buffer.data(), static_cast<std::size_t>(size)), on_record);
+        }
+        scanner.finish(on_record);
+        ::close(fd);
+        bench::do_not_optimize(total);
+    }, 3);
+    bench::report("parallel", "read + stream_scanner (blocking)", blocking_time, data.size());
+
+    for (const std::size_t depth : {2, 3}) {
+        const auto time = bench::measure([&] {
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            std::uint64_t total = 0;
+            const auto stats = stdx::scan_stream<"{%s} {%s} {%s} {%u} {%u}"_fs, std::string_view, std::string_view,
+                                                 std::string_view, std::uint16_t, std::uint64_t>(
+                fd, [&](const auto& record) { total += std::get<4>(record.values()); },
+                {.buffer_size = buffer_size, .depth = depth});
+            ::close(fd);
+            bench::do_not_optimize(total);
+            bench::do_not_optimize(stats);
+        }, 3);
+        bench::report("parallel", "scan_stream read-ahead, depth " + std::to_string(depth), time, data.size());
+    }
+
+#if __has_include(<generator>)
+    const auto generator_time = bench::measure([&] {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        std::uint64_t total = 0;
+        for (const auto& record : stdx::scan_stream<"{%s} {%s} {%s} {%u} {%u}"_fs, std::string_view,
+                                                    std::string_view, std::string_view, std::uint16_t,
+                                                    std::uint64_t>(fd, {.buffer_size = buffer_size})) {
+            total += std::get<4>(record.values());
+        }
+        ::close(fd);
+        bench::do_not_optimize(total);
+    }, 3);
+    bench::report("parallel", "scan_stream read-ahead, std::generator", generator_time, data.size());
+#endif
+
+    std::filesystem::remove(path);
+}
+
+} // namespace
+
+void bench::run_parallel_benchmarks() {
+    const std::string data = make_log();
+
+    // Последовательный разбор с тем же накоплением результатов в вектор
+    const auto serial_time = bench::measure([&] {
+        using record = stdx::details::scan_result<std::string_view, std::string_view, std::string_view,
+                                                  std::uint16_t, std::uint64_t>;
+        std::vector<record> records;
+        stdx::scan_lines<"{%s} {%s} {%s} {%u} {%u}"_fs, std::string_view, std::string_view, std::string_view,
+                         std::uint16_t, std::uint64_t>(data, [&](const record& r) { records.push_back(r); });
+        bench::do_not_optimize(records.size());
+    }, 3);
+    bench::report("parallel", "scan_lines (serial)", serial_time, data.size());
+
+    const std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (std::size_t threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        for (const auto order : {stdx::details::merge_order::input, stdx::details::merge_order::unordered}) {
+            const auto time = bench::measure([&] {
+                const auto result =
+                    stdx::scan_lines_parallel<"{%s} {%s} {%s} {%u} {%u}"_fs, std::string_view, std::string_view,
+                                              std::string_view, std::uint16_t, std::uint64_t>(
+                        data, {.threads = threads, .order = order});
+                bench::do_not_optimize(result.records.size());
+            }, 3);
+            const auto name = "scan_lines_parallel " + std::to_string(threads) + " threads" +
+                              (order == stdx::details::merge_order::input ? ", input order" : ", unordered");
+            bench::report("parallel", name, time, data.size());
+        }
+        if (threads == max_threads) {
+            break;
+        }
+    }
+
+    bench_read_ahead(data);
+}
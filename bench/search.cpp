@@ -0,0 +1,66 @@
+#include "bench.hpp"
+#include "search.hpp"
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace {
+
+using stdx::details::fixed_string;
+using stdx::details::literal_searcher;
+
+constexpr std::size_t DATA_SIZE = 32 << 20;
+
+// Генерирует записи из случайных полей длиной 4..40 символов, разделённых sep
+std::string make_data(std::string_view sep) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> length(4, 40);
+    std::uniform_int_distribution<int> symbol(0, 35);
+
+    std::string data;
+    data.reserve(DATA_SIZE + 64);
+    while (data.size() < DATA_SIZE) {
+        for (int i = length(gen); i > 0; --i) {
+            const int c = symbol(gen);
+            data += static_cast<char>(c < 26 ? 'a' + c : '0' + c - 26);
+        }
+        data += sep;
+    }
+    return data;
+}
+
+template <fixed_string Sep>
+void compare_with_find(std::string_view name) {
+    constexpr std::string_view sep(Sep.data, Sep.size() - 1);
+    const std::string data = make_data(sep);
+    const std::string_view haystack = data;
+
+    const auto find_time = bench::measure([&] {
+        std::size_t count = 0;
+        for (std::size_t pos = haystack.find(sep); pos != std::string_view::npos; pos = haystack.find(sep, pos + 1)) {
+            ++count;
+        }
+        bench::do_not_optimize(count);
+    });
+    const auto searcher_time = bench::measure([&] {
+        std::size_t count = 0;
+        for (std::size_t pos = literal_searcher<Sep>::find(haystack, 0); pos != std::string_view::npos;
+             pos = literal_searcher<Sep>::find(haystack, pos + 1)) {
+            ++count;
+        }
+        bench::do_not_optimize(count);
+    });
+
+    bench::report("search", std::string(name) + " / string_view::find", find_time, data.size());
+    bench::report("search", std::string(name) + " / literal_searcher", searcher_time, data.size());
+}
+
+} // namespace
+
+void bench::run_search_benchmarks() {
+    compare_with_find<" ">("1 byte");
+    compare_with_find<", ">("2 bytes");
+    compare_with_find<" | ">("3 bytes");
+    compare_with_find<"\" \"-\" \"">("7 bytes");
+    compare_with_find<" <-- record separator --> ">("26 bytes");
+}
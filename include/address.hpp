@@ -0,0 +1,162 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+#include "radix.hpp"
+#include "scanner.hpp"
+#include "types.hpp"
+
+namespace stdx {
+
+// Адрес IPv4, байты в сетевом порядке: 10.0.1.2 - {10, 0, 1, 2}
+struct ipv4_address {
+    std::array<std::uint8_t, 4> bytes{};
+
+    // Адрес как число: 10.0.1.2 - 0x0A000102
+    constexpr std::uint32_t value() const {
+        return static_cast<std::uint32_t>(bytes[0]) << 24 | static_cast<std::uint32_t>(bytes[1]) << 16 |
+               static_cast<std::uint32_t>(bytes[2]) << 8 | bytes[3];
+    }
+
+    friend constexpr bool operator==(const ipv4_address&, const ipv4_address&) = default;
+};
+
+// Адрес IPv6, байты в сетевом порядке
+struct ipv6_address {
+    std::array<std::uint8_t, 16> bytes{};
+
+    friend constexpr bool operator==(const ipv6_address&, const ipv6_address&) = default;
+};
+
+} // namespace stdx
+
+namespace stdx::details {
+
+// Разбор IPv4 в четырёхточечной записи, как inet_pton: четыре числа до 255 без ведущих нулей
+constexpr std::expected<ipv4_address, parse_error> parse_ipv4(std::string_view str) {
+    ipv4_address address;
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < 4; ++i) {
+        if (i != 0) {
+            if (pos == str.size() || str[pos] != '.') {
+                return std::unexpected(parse_error{"Failed to parse IPv4 address", error_reason::syntax});
+            }
+            ++pos;
+        }
+        const std::size_t begin = pos;
+        unsigned value = 0;
+        for (; pos < str.size() && pos - begin < 3 && str[pos] >= '0' && str[pos] <= '9'; ++pos) {
+            value = value * 10 + static_cast<unsigned>(str[pos] - '0');
+        }
+        const std::size_t digits = pos - begin;
+        if (digits == 0 || value > 255 || (digits > 1 && str[begin] == '0')) {
+            return std::unexpected(parse_error{"Failed to parse IPv4 address", error_reason::syntax});
+        }
+        address.bytes[i] = static_cast<std::uint8_t>(value);
+    }
+    if (pos != str.size()) {
+        return std::unexpected(parse_error{"Failed to parse IPv4 address", error_reason::syntax});
+    }
+    return address;
+}
+
+// Разбор IPv6 в текстовой записи RFC 4291: восемь групп до 4 шестнадцатеричных цифр, одно сокращение '::'
+// и необязательный IPv4 в последних 32 битах. Идентификатор зоны (%eth0) не поддерживается
+constexpr std::expected<ipv6_address, parse_error> parse_ipv6(std::string_view str) {
+    const auto error = [] { return std::unexpected(parse_error{"Failed to parse IPv6 address", error_reason::syntax}); };
+
+    std::array<std::uint16_t, 8> groups{};
+    std::size_t count = 0;
+    std::size_t gap = groups.size();  // число групп перед '::', size() - сокращения нет
+    std::size_t pos = 0;
+
+    if (str.starts_with("::")) {
+        gap = 0;
+        pos = 2;
+    }
+    while (pos < str.size()) {
+        const std::size_t begin = pos;
+        std::uint16_t value = 0;
+        for (; pos < str.size() && pos - begin < 4 && radix_digit(str[pos]) < 16; ++pos) {
+            value = static_cast<std::uint16_t>(value << 4 | radix_digit(str[pos]));
+        }
+        if (pos == begin || count == groups.size()) {
+            return error();
+        }
+
+        // Последние 32 бита записаны как IPv4
+        if (pos < str.size() && str[pos] == '.') {
+            const auto tail = parse_ipv4(str.substr(begin));
+            if (!tail || count > groups.size() - 2) {
+                return error();
+            }
+            groups[count++] = static_cast<std::uint16_t>(tail->bytes[0] << 8 | tail->bytes[1]);
+            groups[count++] = static_cast<std::uint16_t>(tail->bytes[2] << 8 | tail->bytes[3]);
+            pos = str.size();
+            break;
+        }
+
+        groups[count++] = value;
+        if (pos == str.size()) {
+            break;
+        }
+        if (str[pos] != ':' || ++pos == str.size()) {
+            return error();
+        }
+        if (str[pos] == ':') {
+            // Второе сокращение или сокращение после восьмой группы: gap совпал бы с признаком "сокращения нет"
+            if (gap != groups.size() || count == groups.size()) {
+                return error();
+            }
+            gap = count;
+            ++pos;
+        }
+    }
+
+    if (gap == groups.size() ? count != groups.size() : count == groups.size()) {
+        return error();
+    }
+    // Группы после '::' сдвигаются в конец адреса, пропущенные группы - нули
+    if (gap != groups.size()) {
+        const std::size_t tail = count - gap;
+        for (std::size_t i = 0; i < tail; ++i) {
+            groups[groups.size() - 1 - i] = groups[count - 1 - i];
+            groups[count - 1 - i] = 0;
+        }
+    }
+
+    ipv6_address address;
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        address.bytes[2 * i] = static_cast<std::uint8_t>(groups[i] >> 8);
+        address.bytes[2 * i + 1] = static_cast<std::uint8_t>(groups[i]);
+    }
+    return address;
+}
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Адреса IPv4 и IPv6: {%I}, версия определяется типом поля
+template <>
+struct scanner<ipv4_address> {
+    static constexpr char specifier = 'I';
+
+    static constexpr std::expected<ipv4_address, details::parse_error> parse(std::string_view field) {
+        return details::parse_ipv4(field);
+    }
+};
+
+template <>
+struct scanner<ipv6_address> {
+    static constexpr char specifier = 'I';
+
+    static constexpr std::expected<ipv6_address, details::parse_error> parse(std::string_view field) {
+        return details::parse_ipv6(field);
+    }
+};
+
+} // namespace stdx
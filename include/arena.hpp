@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "format_string.hpp"
+#include "parse.hpp"
+#include "types.hpp"
+
+namespace stdx {
+
+// Память для строковых полей scan_owned, переживающих входной буфер. Строки размещаются подряд в блоках
+// сдвигом указателя, reset() за O(1) делает все блоки снова свободными без освобождения памяти,
+// поэтому после первых пакетов разбор не обращается к malloc. Строки, выданные до reset(), становятся недействительными
+class scan_arena {
+public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit scan_arena(std::size_t block_size = DEFAULT_BLOCK_SIZE) : block_size_(std::max<std::size_t>(block_size, 1)) {}
+
+    scan_arena(const scan_arena&) = delete;
+    scan_arena& operator=(const scan_arena&) = delete;
+
+    // Копия строки в арене
+    std::string_view store(std::string_view str) {
+        if (str.empty()) {
+            return {};
+        }
+        if (static_cast<std::size_t>(limit_ - cursor_) < str.size()) {
+            next_block(str.size());
+        }
+        char* const data = cursor_;
+        std::memcpy(data, str.data(), str.size());
+        cursor_ += str.size();
+        return {data, str.size()};
+    }
+
+    // Копия строки в арене, одинаковые строки до reset() хранятся один раз: для столбцов с небольшим
+    // числом различных значений, например имён хостов
+    std::string_view intern(std::string_view str) {
+        if (2 * (interned_ + 1) > slots_.size()) {
+            grow_table();
+        }
+        const std::size_t hash = std::hash<std::string_view>{}(str);
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+            slot& current = slots_[i];
+            if (current.generation != generation_) {
+                current = {hash, store(str), generation_};
+                ++interned_;
+                return current.value;
+            }
+            if (current.hash == hash && current.value == str) {
+                return current.value;
+            }
+        }
+    }
+
+    // Освобождает все строки арены за O(1): блоки и таблица интернирования остаются для следующего пакета
+    void reset() {
+        current_ = 0;
+        cursor_ = blocks_.empty() ? nullptr : blocks_.front().data.get();
+        limit_ = blocks_.empty() ? nullptr : cursor_ + blocks_.front().size;
+        interned_ = 0;
+        if (++generation_ == 0) {
+            // Поколение переполнилось: старые слоты могли бы совпасть с новым поколением
+            std::fill(slots_.begin(), slots_.end(), slot{});
+            generation_ = 1;
+        }
+    }
+
+    // Память, занятая блоками арены
+    std::size_t capacity() const {
+        std::size_t result = 0;
+        for (const auto& current : blocks_) {
+            result += current.size;
+        }
+        return result;
+    }
+
+private:
+    struct block {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    struct slot {
+        std::size_t hash = 0;
+        std::string_view value;
+        std::uint32_t generation = 0;
+    };
+
+    // Переход к следующему блоку, вмещающему size байт: свободный блок после reset() или новый
+    void next_block(std::size_t size) {
+        std::size_t next = blocks_.empty() ? 0 : current_ + 1;
+        const auto fits = std::find_if(blocks_.begin() + static_cast<std::ptrdiff_t>(next), blocks_.end(),
+                                       [&](const block& candidate) { return candidate.size >= size; });
+        if (fits != blocks_.end()) {
+            std::iter_swap(blocks_.begin() + static_cast<std::ptrdiff_t>(next), fits);
+        } else {
+            const std::size_t block_size = std::max(block_size_, size);
+            blocks_.insert(blocks_.begin() + static_cast<std::ptrdiff_t>(next),
+                           block{std::make_unique_for_overwrite<char[]>(block_size), block_size});
+        }
+        current_ = next;
+        cursor_ = blocks_[current_].data.get();
+        limit_ = cursor_ + blocks_[current_].size;
+    }
+
+    void grow_table() {
+        std::vector<slot> slots(std::max<std::size_t>(2 * slots_.size(), 64));
+        const std::size_t mask = slots.size() - 1;
+        for (const slot& current : slots_) {
+            if (current.generation != generation_) {
+                continue;
+            }
+            std::size_t i = current.hash & mask;
+            while (slots[i].generation == generation_) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = current;
+        }
+        slots_ = std::move(slots);
+    }
+
+    std::size_t block_size_;
+    std::vector<block> blocks_;
+    std::size_t current_ = 0;
+    char* cursor_ = nullptr;
+    char* limit_ = nullptr;
+
+    std::vector<slot> slots_;
+    std::size_t interned_ = 0;
+    std::uint32_t generation_ = 1;
+};
+
+// Номера аргументов scan_owned, строки которых интернируются в арене: scan_owned<fmt, stdx::intern<0, 2>, Ts...>
+template <std::size_t... Is>
+struct intern {
+    static constexpr bool contains(std::size_t index) { return ((index == Is) || ...); }
+};
+
+} // namespace stdx
+
+namespace stdx::details {
+
+template <typename T>
+struct is_intern_policy : std::false_type {};
+
+template <std::size_t... Is>
+struct is_intern_policy<stdx::intern<Is...>> : std::true_type {};
+
+template <typename T>
+concept InternPolicy = is_intern_policy<T>::value;
+
+template <typename... Ts>
+constexpr bool starts_with_intern = false;
+
+template <typename T, typename... Ts>
+constexpr bool starts_with_intern<T, Ts...> = InternPolicy<T>;
+
+// Интернируемые аргументы существуют и имеют строковый тип
+template <typename... Ts, std::size_t... Is>
+consteval bool check_intern_arguments(stdx::intern<Is...>) {
+    return ([] {
+        if constexpr (Is < sizeof...(Ts)) {
+            return SupportedStringType<std::tuple_element_t<Is, std::tuple<Ts...>>>;
+        } else {
+            return false;
+        }
+    }() && ...);
+}
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Runtime-версия scan, строковые поля которой скопированы в arena и остаются действительными после
+// перезаписи input до arena.reset(). Аргументы с номерами из Intern интернируются
+template <details::format_string fmt, details::InternPolicy Intern, typename... Ts>
+std::expected<details::scan_result<Ts...>, details::parse_error> scan_owned(std::string_view input, scan_arena& arena) {
+    static_assert(fmt.number_arguments == sizeof...(Ts),
+        "Number of placeholders must match number of types");
+    static_assert(details::check_intern_arguments<Ts...>(Intern{}),
+        "Interned arguments must be string fields");
+
+    std::tuple<std::remove_cv_t<Ts>...> values{};
+    if (const auto error = details::parse_into<fmt, Ts...>(input, values)) {
+        return std::unexpected(*error);
+    }
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        ([&] {
+            if constexpr (details::SupportedStringType<std::tuple_element_t<Is, std::tuple<Ts...>>>) {
+                auto& value = std::get<Is>(values);
+                value = Intern::contains(Is) ? arena.intern(value) : arena.store(value);
+            }
+        }(), ...);
+    }(std::index_sequence_for<Ts...>{});
+    return std::apply([](const auto&... args) { return details::scan_result<Ts...>(args...); }, values);
+}
+
+template <details::format_string fmt, typename... Ts>
+    requires (!details::starts_with_intern<Ts...>)
+std::expected<details::scan_result<Ts...>, details::parse_error> scan_owned(std::string_view input, scan_arena& arena) {
+    return scan_owned<fmt, intern<>, Ts...>(input, arena);
+}
+
+} // namespace stdx
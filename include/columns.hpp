@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "file.hpp"
+#include "format_string.hpp"
+#include "parse.hpp"
+#include "scan.hpp"
+#include "types.hpp"
+
+namespace stdx::details {
+
+// Ссылка на подстроку исходного буфера: смещение и длина вместо указателя,
+// поэтому столбец не зависит от адреса, по которому буфер отображён
+struct string_ref {
+    std::size_t offset = 0;
+    std::size_t length = 0;
+};
+
+// Тип элемента столбца для значения типа T
+template <typename T>
+struct column_value {
+    using type = std::remove_cv_t<T>;
+};
+
+template <SupportedStringType T>
+struct column_value<T> {
+    using type = string_ref;
+};
+
+template <typename T>
+using column_value_t = typename column_value<T>::type;
+
+// Шаблонный класс для хранения результатов пакетного разбора по столбцам:
+// для каждого плейсхолдера отдельный непрерывный буфер значений
+template <typename... Ts>
+class scan_columns {
+    static_assert(sizeof...(Ts) > 0, "scan_columns requires at least one placeholder");
+
+public:
+    explicit scan_columns(std::string_view source) : source_(source) {}
+
+    void reserve(std::size_t rows) {
+        std::apply([rows](auto&... column) { (column.reserve(rows), ...); }, columns_);
+    }
+
+    std::size_t size() const { return std::get<0>(columns_).size(); }
+
+    std::string_view source() const { return source_; }
+
+    // Добавляет строку результатов, строковые значения должны указывать внутрь source()
+    void push_back(const scan_result<Ts...>& record) {
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            (std::get<Is>(columns_).push_back(to_column_value(std::get<Is>(record.values()))), ...);
+        }(std::index_sequence_for<Ts...>{});
+    }
+
+    // Непрерывный буфер значений I-го плейсхолдера
+    template <std::size_t I>
+    std::span<const column_value_t<std::tuple_element_t<I, std::tuple<Ts...>>>> column() const {
+        return std::get<I>(columns_);
+    }
+
+    // Значение I-го плейсхолдера в строке row, строковые значения восстанавливаются по source()
+    template <std::size_t I>
+    auto get(std::size_t row) const {
+        const auto& value = std::get<I>(columns_)[row];
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(value)>, string_ref>) {
+            return resolve(value);
+        } else {
+            return value;
+        }
+    }
+
+    // Строковое значение по ссылке из столбца
+    std::string_view resolve(const string_ref& ref) const { return source_.substr(ref.offset, ref.length); }
+
+private:
+    template <typename T>
+    column_value_t<T> to_column_value(const T& value) const {
+        if constexpr (SupportedStringType<T>) {
+            return string_ref{static_cast<std::size_t>(value.data() - source_.data()), value.size()};
+        } else {
+            return value;
+        }
+    }
+
+    std::string_view source_;
+    std::tuple<std::vector<column_value_t<Ts>>...> columns_;
+};
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Разбирает каждую строку буфера по формату fmt и дописывает результаты в столбцы columns.
+// Буфер должен совпадать с columns.source() или лежать внутри него
+template <details::format_string fmt, typename... Ts>
+details::scan_stats scan_lines_columnar(std::string_view buffer, details::scan_columns<Ts...>& columns) {
+    return scan_lines<fmt, Ts...>(buffer,
+        [&](const details::scan_result<Ts...>& record) { columns.push_back(record); });
+}
+
+// Разбирает каждую строку буфера по формату fmt в новый столбцовый контейнер
+template <details::format_string fmt, typename... Ts>
+details::scan_columns<Ts...> scan_lines_columnar(std::string_view buffer) {
+    details::scan_columns<Ts...> columns(buffer);
+    columns.reserve(static_cast<std::size_t>(std::ranges::count(buffer, '\n')) + 1);
+    scan_lines_columnar<fmt, Ts...>(buffer, columns);
+    return columns;
+}
+
+} // namespace stdx
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include "format_string.hpp"
+#include "parse.hpp"
+#include "scan.hpp"
+#include "types.hpp"
+
+namespace stdx::details {
+
+// Описание одного из форматов для scan_any: форматирующая строка и типы ее плейсхолдеров
+template <format_string Fmt, typename... Ts>
+struct pattern {
+    static_assert(Fmt.number_arguments == sizeof...(Ts), "Number of placeholders must match number of types");
+
+    static constexpr auto format = Fmt;
+    using result_type = scan_result<Ts...>;
+
+    static constexpr std::string_view prefix() { return get_literal<Fmt, 0>(); }
+
+    // Число литералов после начального, положение которых в строке известно заранее:
+    // перед ними стоят только поля фиксированной ширины
+    static constexpr std::size_t anchored_literals() {
+        std::size_t count = 0;
+        while (count < Fmt.number_placeholders && Fmt.plan.placeholders[count].width != 0) {
+            ++count;
+        }
+        return count;
+    }
+
+    // Байты этих литералов вместе с их позициями в строке
+    static constexpr auto anchors() {
+        constexpr std::size_t literals = anchored_literals();
+        constexpr std::size_t size = [] {
+            std::size_t result = 0;
+            for (std::size_t i = 1; i <= literals; ++i) {
+                result += Fmt.plan.literals[i].length;
+            }
+            return result;
+        }();
+
+        std::array<std::pair<std::size_t, char>, size> result{};
+        std::size_t count = 0;
+        std::size_t position = Fmt.plan.literals[0].length;
+        for (std::size_t i = 1; i <= literals; ++i) {
+            position += Fmt.plan.placeholders[i - 1].width;
+            const auto& literal = Fmt.plan.literals[i];
+            for (std::size_t j = 0; j < literal.length; ++j) {
+                result[count++] = {position + j, Fmt.source.data[literal.offset + j]};
+            }
+            position += literal.length;
+        }
+        return result;
+    }
+
+    static constexpr std::expected<result_type, parse_error> scan(std::string_view input) {
+        return parse_source<Fmt, Ts...>(input);
+    }
+};
+
+// Префиксное дерево по начальным литералам форматов, строится в compile-time.
+// Узлы хранятся как "первый потомок - следующий брат", accept - маска форматов, чей префикс оканчивается в узле
+template <std::size_t Capacity>
+struct prefix_trie {
+    static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+    struct node {
+        char byte = '\0';
+        std::size_t first_child = none;
+        std::size_t next_sibling = none;
+        std::uint64_t accept = 0;
+    };
+
+    std::array<node, Capacity> nodes{};
+    std::size_t size = 1;
+
+    constexpr std::size_t find_child(std::size_t parent, char byte) const {
+        std::size_t child = nodes[parent].first_child;
+        while (child != none && nodes[child].byte != byte) {
+            child = nodes[child].next_sibling;
+        }
+        return child;
+    }
+
+    constexpr void insert(std::string_view prefix, std::size_t index) {
+        std::size_t current = 0;
+        for (const char byte : prefix) {
+            std::size_t child = find_child(current, byte);
+            if (child == none) {
+                child = size++;
+                nodes[child].byte = byte;
+                nodes[child].next_sibling = nodes[current].first_child;
+                nodes[current].first_child = child;
+            }
+            current = child;
+        }
+        nodes[current].accept |= std::uint64_t{1} << index;
+    }
+
+    // Маска форматов, начальный литерал которых является префиксом input; каждый байт просматривается один раз
+    constexpr std::uint64_t match(std::string_view input) const {
+        std::uint64_t mask = nodes[0].accept;
+        std::size_t current = 0;
+        for (const char byte : input) {
+            current = find_child(current, byte);
+            if (current == none) {
+                break;
+            }
+            mask |= nodes[current].accept;
+        }
+        return mask;
+    }
+};
+
+template <typename... Patterns>
+consteval auto build_prefix_trie() {
+    prefix_trie<(1 + ... + Patterns::prefix().size())> trie{};
+    std::size_t index = 0;
+    (trie.insert(Patterns::prefix(), index++), ...);
+    return trie;
+}
+
+template <typename... Patterns>
+inline constexpr auto patterns_trie = build_prefix_trie<Patterns...>();
+
+// Проверка байтов литералов на известных позициях после начального литерала, строится в compile-time.
+// Позиция хранит маску форматов, которые задают на ней байт, и для каждого возможного байта - маску форматов,
+// которые его допускают. Берутся только позиции, различающие форматы: позиция, где все форматы требуют
+// один и тот же байт, ничего не выбирает
+template <std::size_t Capacity>
+struct position_filter {
+    struct position {
+        std::size_t offset = 0;
+        std::uint64_t constrained = 0;
+        std::size_t first = 0;  // байты позиции - bytes[first, last)
+        std::size_t last = 0;
+    };
+
+    struct byte_mask {
+        char byte = '\0';
+        std::uint64_t accept = 0;
+    };
+
+    std::array<position, Capacity> positions{};
+    std::array<byte_mask, Capacity> bytes{};
+    std::size_t size = 0;
+
+    // Маска форматов, все заранее известные байты которых совпали с input
+    constexpr std::uint64_t match(std::string_view input, std::uint64_t candidates) const {
+        for (std::size_t i = 0; i < size && candidates != 0; ++i) {
+            const position& current = positions[i];
+            std::uint64_t accept = ~current.constrained;
+            if (current.offset < input.size()) {
+                for (std::size_t j = current.first; j < current.last; ++j) {
+                    if (bytes[j].byte == input[current.offset]) {
+                        accept |= bytes[j].accept;
+                        break;
+                    }
+                }
+            }
+            candidates &= accept;
+        }
+        return candidates;
+    }
+};
+
+template <typename... Patterns>
+consteval auto build_position_filter() {
+    constexpr std::size_t capacity = (0 + ... + Patterns::anchors().size());
+    struct anchor {
+        std::size_t offset;
+        char byte;
+        std::size_t index;
+    };
+    std::array<anchor, capacity> anchors{};
+    std::size_t count = 0;
+    std::size_t index = 0;
+    ([&] {
+        for (const auto& [offset, byte] : Patterns::anchors()) {
+            anchors[count++] = {offset, byte, index};
+        }
+        ++index;
+    }(), ...);
+    std::sort(anchors.begin(), anchors.end(), [](const anchor& lhs, const anchor& rhs) {
+        return lhs.offset != rhs.offset ? lhs.offset < rhs.offset : lhs.byte < rhs.byte;
+    });
+
+    constexpr std::uint64_t all = sizeof...(Patterns) == 64 ? ~std::uint64_t{0}
+                                                            : (std::uint64_t{1} << sizeof...(Patterns)) - 1;
+    position_filter<capacity> filter{};
+    std::size_t bytes = 0;
+    for (std::size_t begin = 0; begin < count;) {
+        auto& current = filter.positions[filter.size];
+        current = {anchors[begin].offset, 0, bytes, bytes};
+        std::size_t end = begin;
+        for (; end < count && anchors[end].offset == current.offset; ++end) {
+            current.constrained |= std::uint64_t{1} << anchors[end].index;
+            if (end == begin || anchors[end].byte != anchors[end - 1].byte) {
+                filter.bytes[bytes++] = {anchors[end].byte, 0};
+            }
+            filter.bytes[bytes - 1].accept |= std::uint64_t{1} << anchors[end].index;
+        }
+        current.last = bytes;
+        if (current.constrained == all && current.last - current.first == 1) {
+            bytes = current.first;
+        } else {
+            ++filter.size;
+        }
+        begin = end;
+    }
+    return filter;
+}
+
+template <typename... Patterns>
+inline constexpr auto patterns_filter = build_position_filter<Patterns...>();
+
+// Форматы, которые могут подойти к input: начальный литерал совпал по префиксному дереву,
+// а байты литералов на известных позициях - по position_filter
+template <typename... Patterns>
+constexpr std::uint64_t dispatch_candidates(std::string_view input) {
+    return patterns_filter<Patterns...>.match(input, patterns_trie<Patterns...>.match(input));
+}
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Разбор строки одним из нескольких форматов. Начальные литералы всех форматов сводятся
+// в compile-time в префиксное дерево, поэтому строка проходится по нему один раз. Литералы после полей
+// фиксированной ширины стоят на известных позициях, их различающие байты проверяются по таблице,
+// так что формат может начинаться и с плейсхолдера: "{%10s} {%8s} GET {}". Полный разбор выполняется
+// только для форматов, прошедших обе проверки, в порядке их перечисления. Форматы, различающиеся лишь
+// литералами после поля без ширины ("{} GET {}" и "{} PUT {}"), так не различить - они разбираются по очереди
+template <typename... Patterns>
+constexpr std::expected<std::variant<typename Patterns::result_type...>, details::parse_error>
+scan_any(std::string_view input) {
+    static_assert(sizeof...(Patterns) > 0, "scan_any requires at least one pattern");
+    static_assert(sizeof...(Patterns) <= 64, "scan_any supports at most 64 patterns");
+
+    using variant_type = std::variant<typename Patterns::result_type...>;
+    const std::uint64_t candidates = details::dispatch_candidates<Patterns...>(input);
+    std::optional<variant_type> result;
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        ([&] {
+            if (!(candidates & (std::uint64_t{1} << Is))) {
+                return false;
+            }
+            auto scanned = Patterns::scan(input);
+            if (!scanned) {
+                return false;
+            }
+            result.emplace(std::in_place_index<Is>, std::move(*scanned));
+            return true;
+        }() || ...);
+    }(std::index_sequence_for<Patterns...>{});
+
+    if (!result) {
+        return std::unexpected(details::parse_error{"No matching format"});
+    }
+    return std::move(*result);
+}
+
+} // namespace stdx
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "format_string.hpp"
+#include "scan.hpp"
+#include "search.hpp"
+#include "types.hpp"
+
+namespace stdx::details {
+
+// Счётчики строк, обработанных при пакетном разборе
+struct scan_stats {
+    std::size_t matched = 0;
+    std::size_t failed = 0;
+};
+
+// Файл, отображённый в память только для чтения
+class mapped_file {
+public:
+    static std::expected<mapped_file, std::error_code> open(const std::filesystem::path& path);
+
+    mapped_file(mapped_file&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+    mapped_file& operator=(mapped_file&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~mapped_file() { unmap(); }
+
+    std::string_view view() const { return {data_, size_}; }
+
+private:
+    mapped_file(const char* data, std::size_t size) : data_(data), size_(size) {}
+
+    void unmap() {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+inline std::expected<mapped_file, std::error_code> mapped_file::open(const std::filesystem::path& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return std::unexpected(std::error_code(errno, std::generic_category()));
+    }
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        const int error = errno;
+        ::close(fd);
+        return std::unexpected(std::error_code(error, std::generic_category()));
+    }
+
+    // Пустой файл отображать не нужно, да и mmap нулевой длины завершается ошибкой
+    const auto size = static_cast<std::size_t>(info.st_size);
+    if (size == 0) {
+        ::close(fd);
+        return mapped_file(nullptr, 0);
+    }
+
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    const int error = errno;
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return std::unexpected(std::error_code(error, std::generic_category()));
+    }
+    ::madvise(data, size, MADV_SEQUENTIAL);
+
+    return mapped_file(static_cast<const char*>(data), size);
+}
+
+// Вызывает on_line для каждой строки буфера без копирования, завершающий '\r' отбрасывается.
+// Обход прекращается на первой строке, для которой on_line вернул false
+template <typename F>
+void for_each_line_until(std::string_view buffer, F&& on_line) {
+    std::size_t begin = 0;
+    while (begin < buffer.size()) {
+        const std::size_t newline = literal_searcher<fixed_string{"\n"}>::find(buffer, begin);
+        const std::size_t end = (newline == std::string_view::npos) ? buffer.size() : newline;
+
+        auto line = buffer.substr(begin, end - begin);
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+        if (!on_line(line)) {
+            return;
+        }
+        begin = end + 1;
+    }
+}
+
+// Вызывает on_line для каждой строки буфера без копирования, завершающий '\r' отбрасывается
+template <typename F>
+void for_each_line(std::string_view buffer, F&& on_line) {
+    for_each_line_until(buffer, [&](std::string_view line) {
+        on_line(line);
+        return true;
+    });
+}
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Разбирает каждую строку буфера по формату fmt и передаёт результаты в on_record.
+// Строковые значения результатов указывают на сам буфер, строки не копируются
+template <details::format_string fmt, typename... Ts, typename F>
+details::scan_stats scan_lines(std::string_view buffer, F&& on_record) {
+    details::scan_stats stats;
+    details::for_each_line(buffer, [&](std::string_view line) {
+        auto result = scan<fmt, Ts...>(line);
+        if (result) {
+            ++stats.matched;
+            on_record(*result);
+        } else {
+            ++stats.failed;
+        }
+    });
+    return stats;
+}
+
+// Отображает файл в память и разбирает каждую его строку по формату fmt.
+// Результаты, переданные в on_record, действительны только во время вызова
+template <details::format_string fmt, typename... Ts, typename F>
+std::expected<details::scan_stats, std::error_code> scan_file(const std::filesystem::path& path, F&& on_record) {
+    auto file = details::mapped_file::open(path);
+    if (!file) {
+        return std::unexpected(file.error());
+    }
+    return scan_lines<fmt, Ts...>(file->view(), std::forward<F>(on_record));
+}
+
+} // namespace stdx
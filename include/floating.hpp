@@ -0,0 +1,638 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <concepts>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include "integer.hpp"
+#include "types.hpp"
+
+namespace stdx::details {
+
+// Параметры двоичного формата чисел с плавающей точкой для алгоритма Эйзеля-Лемира
+template <typename T>
+struct binary_format;
+
+template <>
+struct binary_format<double> {
+    using bits_type = std::uint64_t;
+    static constexpr int mantissa_bits = 52;
+    static constexpr int minimum_exponent = -1023;
+    static constexpr int infinite_power = 0x7FF;
+    static constexpr int fast_path_exponent = 22;
+    static constexpr std::uint64_t fast_path_mantissa = std::uint64_t{1} << 53;
+    static constexpr int min_round_to_even = -4;
+    static constexpr int max_round_to_even = 23;
+    static constexpr int smallest_power_of_ten = -342;
+    static constexpr int largest_power_of_ten = 308;
+    // Больше цифр не влияет на округление: середина между соседними double содержит не более 767 цифр
+    static constexpr std::size_t max_digits = 769;
+};
+
+template <>
+struct binary_format<float> {
+    using bits_type = std::uint32_t;
+    static constexpr int mantissa_bits = 23;
+    static constexpr int minimum_exponent = -127;
+    static constexpr int infinite_power = 0xFF;
+    static constexpr int fast_path_exponent = 10;
+    static constexpr std::uint64_t fast_path_mantissa = std::uint64_t{1} << 24;
+    static constexpr int min_round_to_even = -17;
+    static constexpr int max_round_to_even = 10;
+    static constexpr int smallest_power_of_ten = -65;
+    static constexpr int largest_power_of_ten = 38;
+    static constexpr std::size_t max_digits = 114;
+};
+
+// Целое без знака произвольной длины на 32-битных словах для построения таблицы степеней пятёрки
+// и точного сравнения в медленном пути, когда значащих цифр больше 19
+template <std::size_t Words>
+struct big_integer {
+    std::array<std::uint32_t, Words> words{};
+    std::size_t size = 0;
+
+    constexpr void mul_small(std::uint32_t factor) {
+        std::uint64_t carry = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            const std::uint64_t product = static_cast<std::uint64_t>(words[i]) * factor + carry;
+            words[i] = static_cast<std::uint32_t>(product);
+            carry = product >> 32;
+        }
+        if (carry != 0 && size < Words) {
+            words[size++] = static_cast<std::uint32_t>(carry);
+        }
+    }
+
+    constexpr void add_small(std::uint32_t value) {
+        for (std::size_t i = 0; value != 0; ++i) {
+            if (i == size) {
+                words[size++] = value;
+                return;
+            }
+            const std::uint64_t sum = static_cast<std::uint64_t>(words[i]) + value;
+            words[i] = static_cast<std::uint32_t>(sum);
+            value = static_cast<std::uint32_t>(sum >> 32);
+        }
+    }
+
+    constexpr void mul_pow5(std::size_t exponent) {
+        // 5^13 - наибольшая степень пятёрки, помещающаяся в 32 бита
+        for (; exponent >= 13; exponent -= 13) {
+            mul_small(1220703125);
+        }
+        std::uint32_t rest = 1;
+        for (; exponent > 0; --exponent) {
+            rest *= 5;
+        }
+        mul_small(rest);
+    }
+
+    // Деление на небольшое число с отбрасыванием остатка
+    constexpr void div_small(std::uint32_t divisor) {
+        std::uint64_t remainder = 0;
+        for (std::size_t i = size; i-- > 0;) {
+            const std::uint64_t current = (remainder << 32) | words[i];
+            words[i] = static_cast<std::uint32_t>(current / divisor);
+            remainder = current % divisor;
+        }
+        while (size > 0 && words[size - 1] == 0) {
+            --size;
+        }
+    }
+
+    constexpr void shift_left(std::size_t bits) {
+        if (size == 0) {
+            return;
+        }
+        const std::size_t word_shift = bits / 32;
+        const std::size_t bit_shift = bits % 32;
+        const std::size_t new_size = size + word_shift + 1 < Words ? size + word_shift + 1 : Words;
+        for (std::size_t i = new_size; i-- > 0;) {
+            std::uint32_t value = 0;
+            if (i >= word_shift && i - word_shift < size) {
+                value = words[i - word_shift] << bit_shift;
+            }
+            if (bit_shift != 0 && i >= word_shift + 1 && i - word_shift - 1 < size) {
+                value |= words[i - word_shift - 1] >> (32 - bit_shift);
+            }
+            words[i] = value;
+        }
+        size = new_size;
+        while (size > 0 && words[size - 1] == 0) {
+            --size;
+        }
+    }
+
+    constexpr std::size_t bit_length() const {
+        return size == 0 ? 0 : (size - 1) * 32 + (32 - std::countl_zero(words[size - 1]));
+    }
+
+    // Биты [from, from + 64) числа
+    constexpr std::uint64_t bits_at(std::size_t from) const {
+        const auto word = [&](std::size_t index) -> std::uint64_t { return index < size ? words[index] : 0; };
+        const std::size_t index = from / 32;
+        const std::size_t shift = from % 32;
+        // Три слова покрывают 64 бита при любом сдвиге внутри первого слова
+        const std::uint64_t low = word(index) | word(index + 1) << 32;
+        return shift == 0 ? low : (low >> shift) | word(index + 2) << (64 - shift);
+    }
+
+    friend constexpr int compare(const big_integer& lhs, const big_integer& rhs) {
+        if (lhs.size != rhs.size) {
+            return lhs.size < rhs.size ? -1 : 1;
+        }
+        for (std::size_t i = lhs.size; i-- > 0;) {
+            if (lhs.words[i] != rhs.words[i]) {
+                return lhs.words[i] < rhs.words[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+};
+
+// Старшие 128 бит числа: при большей длине лишние младшие биты отбрасываются
+template <std::size_t Words>
+constexpr std::array<std::uint64_t, 2> top_128_bits(const big_integer<Words>& value) {
+    const std::size_t length = value.bit_length();
+    const std::size_t from = length > 128 ? length - 128 : 0;
+    return {value.bits_at(from + 64), value.bits_at(from)};
+}
+
+// Таблица 128-битных приближений 5^q для q из [-342, 308], нормализованных так, что старший бит равен 1.
+// Для q < 0 хранится floor(2^b / 5^-q) + 1, усечённое до 128 бит. Шаблон откладывает построение
+// таблицы до первого использования, поэтому единицы трансляции без {%f} за неё не платят
+template <typename = void>
+struct powers_of_five {
+    static constexpr int smallest = binary_format<double>::smallest_power_of_ten;
+    static constexpr int largest = binary_format<double>::largest_power_of_ten;
+    static constexpr std::size_t count = largest - smallest + 1;
+
+    static consteval std::array<std::uint64_t, 2 * count> build() {
+        std::array<std::uint64_t, 2 * count> table{};
+
+        // 5^342 занимает 795 бит, поэтому 2^(2 * 795 + 128) делится на все нужные степени
+        constexpr std::size_t max_bits = 2 * 795 + 128;
+        big_integer<max_bits / 32 + 2> quotient;
+        quotient.size = max_bits / 32 + 1;
+        quotient.words[max_bits / 32] = std::uint32_t{1} << (max_bits % 32);
+
+        big_integer<32> power;
+        power.words[0] = 1;
+        power.size = 1;
+        for (int k = 1; k <= -smallest; ++k) {
+            power.mul_small(5);
+            quotient.div_small(5);
+
+            // floor(2^b / 5^k) = floor(floor(2^max_bits / 5^k) / 2^(max_bits - b))
+            const std::size_t z = power.bit_length();
+            const std::size_t b = (k <= 27) ? z + 127 : 2 * z + 128;
+            const std::size_t drop = max_bits - b;
+            big_integer<max_bits / 32 + 2> shifted;
+            for (std::size_t i = 0; drop + i * 32 < quotient.bit_length(); ++i) {
+                shifted.words[i] = static_cast<std::uint32_t>(quotient.bits_at(drop + i * 32));
+                shifted.size = i + 1;
+            }
+            while (shifted.size > 0 && shifted.words[shifted.size - 1] == 0) {
+                --shifted.size;
+            }
+            shifted.add_small(1);
+
+            const auto bits = top_128_bits(shifted);
+            const std::size_t index = static_cast<std::size_t>(-k - smallest);
+            table[2 * index] = bits[0];
+            table[2 * index + 1] = bits[1];
+        }
+
+        big_integer<32> positive;
+        positive.words[0] = 1;
+        positive.size = 1;
+        for (int q = 0; q <= largest; ++q) {
+            // Степени до 5^55 помещаются в 128 бит и дополняются нулями справа
+            big_integer<32> normalized = positive;
+            if (normalized.bit_length() < 128) {
+                normalized.shift_left(128 - normalized.bit_length());
+            }
+            const auto bits = top_128_bits(normalized);
+            const std::size_t index = static_cast<std::size_t>(q - smallest);
+            table[2 * index] = bits[0];
+            table[2 * index + 1] = bits[1];
+            positive.mul_small(5);
+        }
+        return table;
+    }
+
+    static constexpr auto table = build();
+};
+
+// Произведение 64 x 64 -> 128 бит
+struct uint128_parts {
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+};
+
+constexpr uint128_parts full_multiplication(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+    return {static_cast<std::uint64_t>(product >> 64), static_cast<std::uint64_t>(product)};
+#else
+    const std::uint64_t a_low = static_cast<std::uint32_t>(a), a_high = a >> 32;
+    const std::uint64_t b_low = static_cast<std::uint32_t>(b), b_high = b >> 32;
+    const std::uint64_t low_low = a_low * b_low, high_low = a_high * b_low;
+    const std::uint64_t low_high = a_low * b_high, high_high = a_high * b_high;
+    const std::uint64_t middle = (low_low >> 32) + static_cast<std::uint32_t>(high_low) + low_high;
+    return {high_high + (high_low >> 32) + (middle >> 32), (middle << 32) | static_cast<std::uint32_t>(low_low)};
+#endif
+}
+
+// Результат преобразования: мантисса без скрытого бита и смещённый двоичный порядок
+struct adjusted_mantissa {
+    std::uint64_t mantissa = 0;
+    int power2 = 0;
+
+    friend constexpr bool operator==(const adjusted_mantissa&, const adjusted_mantissa&) = default;
+};
+
+// Алгоритм Эйзеля-Лемира: корректно округлённое значение w * 10^q для w, содержащего не более 19 цифр
+template <typename T>
+constexpr adjusted_mantissa compute_float(std::int64_t q, std::uint64_t w) {
+    using format = binary_format<T>;
+    if (w == 0 || q < format::smallest_power_of_ten) {
+        return {};
+    }
+    if (q > format::largest_power_of_ten) {
+        return {0, format::infinite_power};
+    }
+
+    const int leading_zeros = std::countl_zero(w);
+    w <<= leading_zeros;
+
+    // Второе слово приближения нужно, только если младшие биты первого произведения не определяют результат
+    const auto& table = powers_of_five<>::table;
+    const std::size_t index = 2 * static_cast<std::size_t>(q - powers_of_five<>::smallest);
+    constexpr std::uint64_t precision_mask = ~std::uint64_t{0} >> (format::mantissa_bits + 3);
+    uint128_parts product = full_multiplication(w, table[index]);
+    if ((product.high & precision_mask) == precision_mask) {
+        const uint128_parts second = full_multiplication(w, table[index + 1]);
+        product.low += second.high;
+        if (second.high > product.low) {
+            ++product.high;
+        }
+    }
+
+    const int upper_bit = static_cast<int>(product.high >> 63);
+    const int shift = upper_bit + 64 - format::mantissa_bits - 3;
+    adjusted_mantissa answer;
+    answer.mantissa = product.high >> shift;
+    // floor(log2(10^q)) + 63 через приближение log2(10) ~ 217706 / 2^16
+    const int power = static_cast<int>(((152170 + 65536) * q) >> 16) + 63;
+    answer.power2 = power + upper_bit - leading_zeros - format::minimum_exponent;
+
+    // Денормализованные числа
+    if (answer.power2 <= 0) {
+        if (-answer.power2 + 1 >= 64) {
+            return {};
+        }
+        answer.mantissa >>= -answer.power2 + 1;
+        answer.mantissa += answer.mantissa & 1;
+        answer.mantissa >>= 1;
+        answer.power2 = (answer.mantissa < (std::uint64_t{1} << format::mantissa_bits)) ? 0 : 1;
+        return answer;
+    }
+
+    // Точная середина между соседними значениями округляется к чётному
+    if (product.low <= 1 && q >= format::min_round_to_even && q <= format::max_round_to_even &&
+        (answer.mantissa & 3) == 1 && (answer.mantissa << shift) == product.high) {
+        answer.mantissa &= ~std::uint64_t{1};
+    }
+
+    answer.mantissa += answer.mantissa & 1;
+    answer.mantissa >>= 1;
+    if (answer.mantissa >= (std::uint64_t{2} << format::mantissa_bits)) {
+        answer.mantissa = std::uint64_t{1} << format::mantissa_bits;
+        ++answer.power2;
+    }
+    answer.mantissa &= ~(std::uint64_t{1} << format::mantissa_bits);
+    if (answer.power2 >= format::infinite_power) {
+        return {0, format::infinite_power};
+    }
+    return answer;
+}
+
+// Разобранная десятичная запись: первые не более 19 значащих цифр и порядок, truncated - отброшены ненулевые цифры
+struct decimal_number {
+    std::uint64_t mantissa = 0;
+    std::int64_t exponent = 0;
+    bool negative = false;
+    bool truncated = false;
+};
+
+// Число больше любого разумного порядка, но без переполнения при сложении со смещениями
+constexpr std::int64_t DECIMAL_EXPONENT_LIMIT = 1 << 20;
+
+// Первые 19 значащих цифр записи длиннее 19 цифр: остальные цифры целой части увеличивают порядок,
+// truncated выставляется, только если среди отброшенных есть ненулевые
+constexpr void truncate_mantissa(const char* p, const char* end, decimal_number& result) {
+    result.mantissa = 0;
+    result.exponent = 0;
+    int significant = 0;
+    bool fraction = false;
+    for (; p != end; ++p) {
+        if (*p == '.') {
+            fraction = true;
+            continue;
+        }
+        const auto digit = static_cast<std::uint64_t>(*p - '0');
+        if (result.mantissa == 0 && digit == 0) {
+            // Ведущие нули дробной части сдвигают порядок, нули целой части ни на что не влияют
+            result.exponent -= fraction ? 1 : 0;
+        } else if (significant < 19) {
+            result.mantissa = result.mantissa * 10 + digit;
+            ++significant;
+            result.exponent -= fraction ? 1 : 0;
+        } else {
+            result.exponent += fraction ? 0 : 1;
+            result.truncated = result.truncated || digit != 0;
+        }
+    }
+}
+
+// Разбор записи вида -123.456e-7 целиком, без ведущего '+' и пробелов, как std::from_chars.
+// Цифры накапливаются за один проход, в runtime дробная часть - по 8 цифр SWAR; мантисса длиннее 19 цифр
+// переполняет uint64_t, и тогда цифры перечитываются с усечением
+constexpr std::expected<decimal_number, parse_error> parse_decimal(std::string_view str) {
+    decimal_number result;
+    const char* p = str.data();
+    const char* const end = p + str.size();
+    if (p != end && *p == '-') {
+        result.negative = true;
+        ++p;
+    }
+
+    const char* const digits_begin = p;
+    std::uint64_t mantissa = 0;
+    for (; p != end && is_digit(*p); ++p) {
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+    }
+    auto digits = static_cast<std::size_t>(p - digits_begin);
+    std::int64_t fraction_digits = 0;
+    if (p != end && *p == '.') {
+        ++p;
+        const char* const fraction_begin = p;
+        if !consteval {
+            if constexpr (swar::available) {
+                while (end - p >= 8 && swar::all_digits8(swar::load8(p))) {
+                    mantissa = mantissa * 100000000 + swar::convert8(swar::load8(p));
+                    p += 8;
+                }
+            }
+        }
+        for (; p != end && is_digit(*p); ++p) {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+        }
+        fraction_digits = p - fraction_begin;
+        digits += static_cast<std::size_t>(fraction_digits);
+    }
+    if (digits == 0) {
+        return std::unexpected(parse_error{"Failed to parse float", error_reason::syntax});
+    }
+    const char* const digits_end = p;
+
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negative_exponent = false;
+        if (p != end && (*p == '-' || *p == '+')) {
+            negative_exponent = *p == '-';
+            ++p;
+        }
+        if (p == end || !is_digit(*p)) {
+            return std::unexpected(parse_error{"Failed to parse float", error_reason::syntax});
+        }
+        std::int64_t exponent = 0;
+        for (; p != end && is_digit(*p); ++p) {
+            if (exponent < DECIMAL_EXPONENT_LIMIT) {
+                exponent = exponent * 10 + (*p - '0');
+            }
+        }
+        result.exponent += negative_exponent ? -exponent : exponent;
+    }
+
+    if (p != end) {
+        return std::unexpected(parse_error{"Extra characters after float", error_reason::extra});
+    }
+
+    if (digits > 19) {
+        const std::int64_t written_exponent = result.exponent;
+        truncate_mantissa(digits_begin, digits_end, result);
+        result.exponent += written_exponent;
+    } else {
+        result.mantissa = mantissa;
+        result.exponent -= fraction_digits;
+    }
+    return result;
+}
+
+// Медленный путь для записей длиннее 19 значащих цифр: результат - либо candidate, либо следующее значение.
+// Точное сравнение всей десятичной записи с серединой между ними на длинной арифметике
+template <typename T>
+constexpr adjusted_mantissa compare_halfway(std::string_view str, adjusted_mantissa candidate) {
+    using format = binary_format<T>;
+    // Значащих цифр не больше max_digits, а степени пятёрки не длиннее 2700 бит
+    using big = big_integer<128>;
+
+    // Все значащие цифры как целое digits и порядок exponent: значение = digits * 10^exponent
+    big digits;
+    std::int64_t exponent = 0;
+    std::size_t count = 0;
+    bool sticky = false;
+    std::uint32_t chunk = 0;
+    std::uint32_t chunk_scale = 1;
+    std::size_t pos = (!str.empty() && str[0] == '-') ? 1 : 0;
+    bool fraction = false;
+    for (; pos < str.size(); ++pos) {
+        const char c = str[pos];
+        if (c == '.') {
+            fraction = true;
+            continue;
+        }
+        if (!is_digit(c)) {
+            break;
+        }
+        if (count == 0 && c == '0') {
+            exponent -= fraction ? 1 : 0;
+            continue;
+        }
+        if (count == format::max_digits) {
+            exponent += fraction ? 0 : 1;
+            sticky = sticky || c != '0';
+            continue;
+        }
+        chunk = chunk * 10 + static_cast<std::uint32_t>(c - '0');
+        chunk_scale *= 10;
+        ++count;
+        exponent -= fraction ? 1 : 0;
+        if (chunk_scale == 1000000000) {
+            digits.mul_small(chunk_scale);
+            digits.add_small(chunk);
+            chunk = 0;
+            chunk_scale = 1;
+        }
+    }
+    if (digits.size == 0) {
+        digits.words[0] = chunk;
+        digits.size = chunk != 0 ? 1 : 0;
+    } else if (chunk_scale != 1) {
+        digits.mul_small(chunk_scale);
+        digits.add_small(chunk);
+    }
+    if (pos < str.size()) {
+        std::int64_t written = 0;
+        bool negative_exponent = false;
+        ++pos;
+        if (str[pos] == '-' || str[pos] == '+') {
+            negative_exponent = str[pos] == '-';
+            ++pos;
+        }
+        for (; pos < str.size(); ++pos) {
+            if (written < DECIMAL_EXPONENT_LIMIT) {
+                written = written * 10 + (str[pos] - '0');
+            }
+        }
+        exponent += negative_exponent ? -written : written;
+    }
+
+    // Середина между candidate и следующим значением: (2m + 1) * 2^(e - 1)
+    std::uint64_t mantissa = candidate.mantissa;
+    std::int64_t binary_exponent = 0;
+    if (candidate.power2 == 0) {
+        binary_exponent = 1 + format::minimum_exponent - format::mantissa_bits;
+    } else {
+        mantissa |= std::uint64_t{1} << format::mantissa_bits;
+        binary_exponent = candidate.power2 + format::minimum_exponent - format::mantissa_bits;
+    }
+    big halfway;
+    const std::uint64_t doubled = 2 * mantissa + 1;
+    halfway.words[0] = static_cast<std::uint32_t>(doubled);
+    halfway.words[1] = static_cast<std::uint32_t>(doubled >> 32);
+    halfway.size = halfway.words[1] != 0 ? 2 : 1;
+    --binary_exponent;
+
+    // digits * 5^exponent * 2^exponent сравнивается с halfway * 2^binary_exponent
+    if (exponent >= 0) {
+        digits.mul_pow5(static_cast<std::size_t>(exponent));
+    } else {
+        halfway.mul_pow5(static_cast<std::size_t>(-exponent));
+    }
+    if (exponent > binary_exponent) {
+        digits.shift_left(static_cast<std::size_t>(exponent - binary_exponent));
+    } else {
+        halfway.shift_left(static_cast<std::size_t>(binary_exponent - exponent));
+    }
+
+    const int order = compare(digits, halfway);
+    const bool round_up = order > 0 || (order == 0 && (sticky || (mantissa & 1) != 0));
+    if (!round_up) {
+        return candidate;
+    }
+
+    // Следующее значение: переполнение мантиссы переносится в порядок
+    adjusted_mantissa next = candidate;
+    ++next.mantissa;
+    if (next.mantissa == (std::uint64_t{1} << format::mantissa_bits)) {
+        next.mantissa = 0;
+        ++next.power2;
+    }
+    if (next.power2 >= format::infinite_power) {
+        return {0, format::infinite_power};
+    }
+    return next;
+}
+
+// Точные степени десяти для быстрого пути Клингера
+template <typename T>
+constexpr T exact_power_of_ten(int exponent) {
+    constexpr T powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    return powers[exponent];
+}
+
+// Сравнение без учёта регистра со словом из строчных букв
+constexpr bool equals_ignore_case(std::string_view str, std::string_view lower) {
+    if (str.size() != lower.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < str.size(); ++i) {
+        if ((str[i] | 0x20) != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Бесконечность и NaN: inf, infinity и nan в любом регистре с необязательным '-'
+template <typename T>
+constexpr std::optional<T> parse_special(std::string_view str) {
+    const bool negative = str.starts_with('-');
+    const auto word = str.substr(negative ? 1 : 0);
+    if (equals_ignore_case(word, "inf") || equals_ignore_case(word, "infinity")) {
+        return negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+    }
+    if (equals_ignore_case(word, "nan")) {
+        return negative ? -std::numeric_limits<T>::quiet_NaN() : std::numeric_limits<T>::quiet_NaN();
+    }
+    return std::nullopt;
+}
+
+// Проверка, что строка является числом с плавающей точкой, без преобразования в двоичный формат
+constexpr bool is_float_text(std::string_view str) {
+    return parse_decimal(str).has_value() || parse_special<double>(str).has_value();
+}
+
+// Разбор числа с плавающей точкой с корректным округлением, как у std::from_chars, но и в compile-time.
+// Короткие записи, мантисса и степень десяти которых точно представимы, считаются одним умножением или делением,
+// остальные - алгоритмом Эйзеля-Лемира, записи длиннее 19 значащих цифр в спорных случаях - длинной арифметикой
+template <std::floating_point T>
+constexpr std::expected<T, parse_error> parse_float(std::string_view str) {
+    using BaseType = std::remove_cv_t<T>;
+    using format = binary_format<BaseType>;
+
+    const auto decimal = parse_decimal(str);
+    if (!decimal) {
+        if (const auto special = parse_special<BaseType>(str)) {
+            return *special;
+        }
+        return std::unexpected(decimal.error());
+    }
+
+    if (!decimal->truncated && decimal->mantissa <= format::fast_path_mantissa &&
+        decimal->exponent >= -format::fast_path_exponent && decimal->exponent <= format::fast_path_exponent) {
+        auto value = static_cast<BaseType>(decimal->mantissa);
+        if (decimal->exponent < 0) {
+            value /= exact_power_of_ten<BaseType>(static_cast<int>(-decimal->exponent));
+        } else {
+            value *= exact_power_of_ten<BaseType>(static_cast<int>(decimal->exponent));
+        }
+        return decimal->negative ? -value : value;
+    }
+
+    adjusted_mantissa answer = compute_float<BaseType>(decimal->exponent, decimal->mantissa);
+    if (decimal->truncated && answer.power2 != format::infinite_power &&
+        answer != compute_float<BaseType>(decimal->exponent, decimal->mantissa + 1)) {
+        answer = compare_halfway<BaseType>(str, answer);
+    }
+
+    using bits_type = typename format::bits_type;
+    bits_type bits = static_cast<bits_type>(answer.mantissa) |
+                     static_cast<bits_type>(static_cast<bits_type>(answer.power2) << format::mantissa_bits);
+    if (decimal->negative) {
+        bits |= static_cast<bits_type>(bits_type{1} << (sizeof(bits_type) * 8 - 1));
+    }
+    return std::bit_cast<BaseType>(bits);
+}
+
+} // namespace stdx::details
@@ -1,37 +1,90 @@
 #pragma once
 
 #include <expected>
+#include "scanner.hpp"
 #include "types.hpp"
 #include <array>
 #include <cstddef> 
 
 namespace stdx::details {
 
+// Описание плейсхолдера в форматирующей строке
+struct placeholder {
+    std::size_t begin = 0;  // позиция '{'
+    std::size_t end = 0;    // позиция '}'
+    char specifier = '\0';  // '\0', если спецификатор не задан
+    std::size_t width = 0;  // ширина поля в символах, 0 - поле ограничено следующим литералом
+    bool discard = false;   // {%*}, {%*d}: поле проверяется, но не сохраняется в результат
+    std::size_t argument = 0;  // индекс типа в Ts... для сохраняемого поля
+};
+
+// Описание литерала форматирующей строки, расположенного между плейсхолдерами
+struct literal_segment {
+    std::size_t offset = 0;
+    std::size_t length = 0;
+};
+
+// Плоский план разбора: N плейсхолдеров и N + 1 литерал вокруг них.
+// literals[0] предшествует первому плейсхолдеру, literals[N] завершает формат
+template <std::size_t N>
+struct scan_plan {
+    std::array<placeholder, N> placeholders{};
+    std::array<literal_segment, N + 1> literals{};
+
+    // Индексы плейсхолдеров, значения которых сохраняются в результат, в порядке типов Ts...
+    std::array<std::size_t, N> arguments{};
+
+    // Если ширина задана у всех плейсхолдеров, длина записи постоянна,
+    // и каждое поле извлекается по смещению offsets[i] без поиска разделителей
+    bool fixed = false;
+    std::array<std::size_t, N> offsets{};
+    std::size_t record_size = 0;
+};
+
 // Шаблонный класс для хранения форматирующей строки и ее особенностей
 template <auto Str>
 class format_string {
+    // Результат единственного прохода по форматирующей строке
+    struct analysis {
+        std::array<placeholder, Str.size() / 2> placeholders{};
+        std::size_t count = 0;
+        std::size_t arguments = 0;
+    };
+
+    static consteval std::expected<analysis, parse_error> analyze();
+    static constexpr auto analyzed = analyze();
+
 public:
     static constexpr auto source = Str;
     static consteval std::expected<size_t, parse_error> get_number_placeholders();
+    static consteval std::expected<size_t, parse_error> get_number_arguments();
     static consteval auto get_placeholder_positions();
+    static consteval auto get_plan();
     
     static constexpr size_t number_placeholders = [] {
         constexpr auto result = get_number_placeholders();
         static_assert(result.has_value(), "get_number_placeholders failed");
         return result.value();
     }();
+
+    // Число сохраняемых значений: пропускаемые плейсхолдеры не требуют типа в Ts...
+    static constexpr size_t number_arguments = [] {
+        constexpr auto result = get_number_arguments();
+        static_assert(result.has_value(), "get_number_arguments failed");
+        return result.value();
+    }();
     
     static constexpr auto placeholder_positions = get_placeholder_positions();
+    static constexpr auto plan = get_plan();
 };
 
 
 template <auto Str>
-consteval std::expected<size_t, parse_error> 
-format_string<Str>::get_number_placeholders() {
+consteval auto format_string<Str>::analyze() -> std::expected<analysis, parse_error> {
     constexpr size_t N = Str.size();
+    analysis result{};
     if (!N)
-        return 0;
-    size_t placeholder_count = 0;
+        return result;
     size_t pos = 0;
     const size_t size = N - 1; // -1 для игнорирования нуль-терминатора
 
@@ -48,73 +101,127 @@ format_string<Str>::get_number_placeholders() {
         }
 
         // Начало плейсхолдера
-        ++placeholder_count;
+        placeholder& current = result.placeholders[result.count++];
+        current.begin = pos;
         ++pos;
 
         // Проверка спецификатора формата
         if (Str.data[pos] == '%') {
             ++pos;
+
+            // Пропускаемое поле: {%*} или {%*d}
+            if (pos < size && Str.data[pos] == '*') {
+                current.discard = true;
+                ++pos;
+            }
+
+            // Необязательная ширина поля перед спецификатором: {%8u}
+            const size_t width_begin = pos;
+            while (pos < size && Str.data[pos] >= '0' && Str.data[pos] <= '9') {
+                current.width = current.width * 10 + static_cast<size_t>(Str.data[pos] - '0');
+                ++pos;
+            }
+            if (pos != width_begin && current.width == 0) {
+                return std::unexpected(parse_error{"Invalid field width"});
+            }
+
             if (pos >= size) {
                 return std::unexpected(parse_error{"Unclosed last placeholder"});
             }
 
-            // Проверяем допустимые спецификаторы
+            // Проверяем допустимые спецификаторы, у пропускаемого поля спецификатор необязателен.
+            // Заглавные буквы - спецификаторы stdx::scanner, их соответствие типу проверяется при разборе
             const char spec = Str.data[pos];
-            constexpr char valid_specs[] = {'d', 'u', 's'};
-            bool valid = false;
-
-            for (const char s : valid_specs) {
-                if (spec == s) {
-                    valid = true;
-                    break;
+            if (!current.discard || spec != '}') {
+                constexpr char valid_specs[] = {'d', 'u', 'x', 'o', 'b', 'f', 's', 'k'};
+                bool valid = is_scanner_specifier(spec);
+
+                for (const char s : valid_specs) {
+                    if (spec == s) {
+                        valid = true;
+                        break;
+                    }
                 }
-            }
 
-            if (!valid) {
-                return std::unexpected(parse_error{"Invalid specifier."});
+                if (!valid) {
+                    return std::unexpected(parse_error{"Invalid specifier."});
+                }
+                current.specifier = spec;
+                ++pos;
             }
-            ++pos;
         }
 
         // Проверяем закрывающую скобку
         if (pos >= size || Str.data[pos] != '}') {
             return std::unexpected(parse_error{"\'}\' hasn't been found in appropriate place"});
         }
+        current.end = pos;
         ++pos;
+
+        if (!current.discard) {
+            current.argument = result.arguments++;
+        }
     }
 
-    return placeholder_count;
+    return result;
 }
 
 template <auto Str>
-consteval auto format_string<Str>::get_placeholder_positions() {
-    constexpr size_t N = Str.size();
-    std::array<std::pair<size_t, size_t>, number_placeholders> positions{};
-    size_t idx = 0;
-    size_t pos = 0;
-    const size_t size = N - 1;
-
-    while (pos < size) {
-        if (Str.data[pos] != '{') {
-            ++pos;
-            continue;
-        }
+consteval std::expected<size_t, parse_error> 
+format_string<Str>::get_number_placeholders() {
+    if (!analyzed.has_value()) {
+        return std::unexpected(analyzed.error());
+    }
+    return analyzed->count;
+}
 
-        size_t start = pos;
-        ++pos; // пропускаем '{'
+template <auto Str>
+consteval std::expected<size_t, parse_error> 
+format_string<Str>::get_number_arguments() {
+    if (!analyzed.has_value()) {
+        return std::unexpected(analyzed.error());
+    }
+    return analyzed->arguments;
+}
 
-        if (pos < size && Str.data[pos] == '%') {
-            ++pos; // пропускаем '%'
-            ++pos; // пропускаем спецификатор
-        }
+template <auto Str>
+consteval auto format_string<Str>::get_placeholder_positions() {
+    std::array<std::pair<size_t, size_t>, number_placeholders> positions{};
+    for (size_t i = 0; i < number_placeholders; ++i) {
+        positions[i] = {analyzed->placeholders[i].begin, analyzed->placeholders[i].end};
+    }
+    return positions;
+}
 
-        if (pos < size && Str.data[pos] == '}') {
-            positions[idx++] = {start, pos};
-            ++pos; // пропускаем '}'
+template <auto Str>
+consteval auto format_string<Str>::get_plan() {
+    scan_plan<number_placeholders> result{};
+    const size_t size = Str.size() ? Str.size() - 1 : 0;
+    size_t literal_begin = 0;
+
+    for (size_t i = 0; i < number_placeholders; ++i) {
+        const auto& current = analyzed->placeholders[i];
+        result.placeholders[i] = current;
+        if (!current.discard) {
+            result.arguments[current.argument] = i;
         }
+        result.literals[i] = {literal_begin, current.begin - literal_begin};
+        literal_begin = current.end + 1;
+    }
+    result.literals[number_placeholders] = {literal_begin, size - literal_begin};
+
+    // Смещения полей в записи, если ширины заданы у всех плейсхолдеров
+    result.fixed = number_placeholders > 0;
+    size_t offset = 0;
+    for (size_t i = 0; i < number_placeholders; ++i) {
+        result.fixed = result.fixed && result.placeholders[i].width != 0;
+        offset += result.literals[i].length;
+        result.offsets[i] = offset;
+        offset += result.placeholders[i].width;
     }
+    result.record_size = offset + result.literals[number_placeholders].length;
 
-    return positions;
+    return result;
 }
 
 namespace literals {
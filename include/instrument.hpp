@@ -0,0 +1,326 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "format_string.hpp"
+#include "parse.hpp"
+#include "types.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace stdx::details {
+
+// Ошибки одного плейсхолдера по этапам разбора, reasons - по этапу (индекс parse_stage) и причине (error_reason)
+struct field_failures {
+    std::uint64_t separator = 0;
+    std::uint64_t conversion = 0;
+    std::array<std::array<std::uint64_t, ERROR_REASON_COUNT>, 2> reasons{};
+};
+
+// Значение метки reason для причины ошибки
+constexpr std::string_view error_reason_name(error_reason reason) {
+    constexpr std::array<std::string_view, ERROR_REASON_COUNT> names{
+        "other", "literal", "width", "syntax", "overflow", "extra", "keyword"};
+    return names[static_cast<std::size_t>(reason)];
+}
+
+// Снимок счётчиков одного формата: строки, байты, ошибки литералов и полей, такты выборочно замеренных строк
+struct scan_counters_snapshot {
+    std::string_view format;
+    std::uint64_t matched = 0;
+    std::uint64_t failed = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t literal_failures = 0;
+    std::vector<field_failures> fields;
+    std::uint64_t sampled = 0;
+    std::uint64_t separator_cycles = 0;
+    std::uint64_t conversion_cycles = 0;
+};
+
+// Такты процессора по TSC, на платформах без него - наносекунды steady_clock
+inline std::uint64_t read_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+class counters_base;
+
+// Все форматы, разобранные с инструментированием хотя бы раз: источник для выгрузки счётчиков
+class counters_registry {
+public:
+    static counters_registry& instance() {
+        static counters_registry registry;
+        return registry;
+    }
+
+    void add(const counters_base* counters) {
+        const std::lock_guard lock(mutex_);
+        counters_.push_back(counters);
+    }
+
+    std::vector<scan_counters_snapshot> snapshot() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<const counters_base*> counters_;
+};
+
+class counters_base {
+public:
+    virtual scan_counters_snapshot snapshot() const = 0;
+
+protected:
+    counters_base() { counters_registry::instance().add(this); }
+    ~counters_base() = default;
+};
+
+inline std::vector<scan_counters_snapshot> counters_registry::snapshot() const {
+    const std::lock_guard lock(mutex_);
+    std::vector<scan_counters_snapshot> result;
+    result.reserve(counters_.size());
+    for (const auto* counters : counters_) {
+        result.push_back(counters->snapshot());
+    }
+    return result;
+}
+
+// Счётчики формата с Fields плейсхолдерами. Обновляются атомарно без упорядочивания,
+// поэтому форматы можно разбирать из нескольких потоков, например в scan_lines_parallel
+template <std::size_t Fields>
+class format_counters final : public counters_base {
+public:
+    explicit format_counters(std::string_view format) : format_(format) {}
+
+    void add(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    scan_counters_snapshot snapshot() const override {
+        const auto load = [](const std::atomic<std::uint64_t>& counter) {
+            return counter.load(std::memory_order_relaxed);
+        };
+        scan_counters_snapshot result{format_,          load(matched), load(failed),
+                                      load(bytes),      load(literal_failures), {},
+                                      load(sampled),    load(cycles[0]),        load(cycles[1])};
+        for (const auto& field : fields) {
+            field_failures failures;
+            for (std::size_t stage = 0; stage < 2; ++stage) {
+                for (std::size_t reason = 0; reason < ERROR_REASON_COUNT; ++reason) {
+                    failures.reasons[stage][reason] = load(field[stage][reason]);
+                }
+            }
+            for (const auto count : failures.reasons[0]) {
+                failures.separator += count;
+            }
+            for (const auto count : failures.reasons[1]) {
+                failures.conversion += count;
+            }
+            result.fields.push_back(failures);
+        }
+        return result;
+    }
+
+    std::atomic<std::uint64_t> matched{0};
+    std::atomic<std::uint64_t> failed{0};
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::uint64_t> literal_failures{0};
+    // Ошибки по плейсхолдерам, индексы - этап parse_stage и причина error_reason
+    std::array<std::array<std::array<std::atomic<std::uint64_t>, ERROR_REASON_COUNT>, 2>, Fields> fields{};
+    std::atomic<std::uint64_t> sampled{0};
+    std::array<std::atomic<std::uint64_t>, 2> cycles{};
+
+private:
+    std::string_view format_;
+};
+
+// Счётчики формата Fmt, регистрируются при первом обращении
+template <auto Fmt>
+format_counters<Fmt.number_placeholders>& counters_for() {
+    static format_counters<Fmt.number_placeholders> counters(
+        std::string_view(Fmt.source.data, Fmt.source.size() - 1));
+    return counters;
+}
+
+// Решение о замере очередной строки: каждая SampleEvery-я строка потока
+template <std::size_t SampleEvery>
+bool next_line_sampled() {
+    if constexpr (SampleEvery == 0) {
+        return false;
+    } else {
+        thread_local std::size_t tick = 0;
+        if (++tick < SampleEvery) {
+            return false;
+        }
+        tick = 0;
+        return true;
+    }
+}
+
+// Точки наблюдения разбора, пишущие в счётчики формата Fmt. Состояние разбираемой строки - признак замера
+// и такты этапов - хранится в потоке и добавляется в счётчики одним обновлением после разбора строки
+template <auto Fmt, InstrumentationPolicy Policy>
+struct counting_probe {
+    struct line_state {
+        bool sampled = false;
+        std::uint64_t start = 0;
+        std::array<std::uint64_t, 2> cycles{};
+    };
+
+    static line_state& line() {
+        thread_local line_state state;
+        return state;
+    }
+
+    static void begin() {
+        if constexpr (Policy::sample_every != 0) {
+            line() = {next_line_sampled<Policy::sample_every>(), 0, {}};
+        }
+    }
+
+    static void enter(parse_stage) {
+        if constexpr (Policy::sample_every != 0) {
+            if (auto& state = line(); state.sampled) {
+                state.start = read_cycles();
+            }
+        }
+    }
+
+    static void leave(parse_stage stage) {
+        if constexpr (Policy::sample_every != 0) {
+            if (auto& state = line(); state.sampled) {
+                state.cycles[static_cast<std::size_t>(stage)] += read_cycles() - state.start;
+            }
+        }
+    }
+
+    static void literal_failed() {
+        auto& counters = counters_for<Fmt>();
+        counters.add(counters.literal_failures, 1);
+    }
+
+    static void field_failed(std::size_t index, parse_stage stage, error_reason reason) {
+        auto& counters = counters_for<Fmt>();
+        counters.add(counters.fields[index][static_cast<std::size_t>(stage)][static_cast<std::size_t>(reason)], 1);
+    }
+
+    static void finish(std::size_t bytes, bool matched) {
+        auto& counters = counters_for<Fmt>();
+        counters.add(matched ? counters.matched : counters.failed, 1);
+        counters.add(counters.bytes, bytes);
+        if constexpr (Policy::sample_every != 0) {
+            if (const auto& state = line(); state.sampled) {
+                counters.add(counters.sampled, 1);
+                counters.add(counters.cycles[0], state.cycles[0]);
+                counters.add(counters.cycles[1], state.cycles[1]);
+            }
+        }
+    }
+};
+
+// Значение метки в текстовом формате Prometheus: экранируются '\', '"' и перевод строки
+inline void write_label(std::ostream& out, std::string_view value) {
+    for (const char c : value) {
+        if (c == '\\' || c == '"') {
+            out << '\\' << c;
+        } else if (c == '\n') {
+            out << "\\n";
+        } else {
+            out << c;
+        }
+    }
+}
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Runtime-версия scan с инструментированием: кроме разбора обновляет счётчики формата fmt - строки
+// разобранные и с ошибкой, байты, ошибки литералов и ошибки по плейсхолдерам, этапам и причинам. Без политики
+// scan<fmt, Ts...> не содержит ни одной точки наблюдения
+template <details::format_string fmt, details::InstrumentationPolicy Policy, typename... Ts>
+std::expected<details::scan_result<Ts...>, details::parse_error> scan(std::string_view input) {
+    static_assert(fmt.number_arguments == sizeof...(Ts),
+        "Number of placeholders must match number of types");
+
+    using probe = details::counting_probe<fmt, Policy>;
+    probe::begin();
+    auto result = details::parse_source<fmt, Ts...>(input, probe{});
+    probe::finish(input.size(), result.has_value());
+    return result;
+}
+
+// Снимок счётчиков формата fmt
+template <details::format_string fmt>
+details::scan_counters_snapshot scan_counters() {
+    return details::counters_for<fmt>().snapshot();
+}
+
+// Снимки счётчиков всех форматов, разобранных с инструментированием
+inline std::vector<details::scan_counters_snapshot> scan_counters() {
+    return details::counters_registry::instance().snapshot();
+}
+
+// Выгрузка счётчиков всех форматов в текстовом формате Prometheus для экспортёра метрик.
+// Ошибки полей выгружаются только для встречавшихся сочетаний этапа и причины
+inline void write_scan_counters(std::ostream& out) {
+    const auto snapshots = scan_counters();
+    const auto series = [&](std::string_view name, const details::scan_counters_snapshot& counters,
+                            std::string_view labels, std::uint64_t value) {
+        out << name << "{format=\"";
+        details::write_label(out, counters.format);
+        out << '"' << labels << "} " << value << '\n';
+    };
+
+    out << "# TYPE stdx_scan_lines_total counter\n";
+    for (const auto& counters : snapshots) {
+        series("stdx_scan_lines_total", counters, ",result=\"matched\"", counters.matched);
+        series("stdx_scan_lines_total", counters, ",result=\"failed\"", counters.failed);
+    }
+    out << "# TYPE stdx_scan_bytes_total counter\n";
+    for (const auto& counters : snapshots) {
+        series("stdx_scan_bytes_total", counters, "", counters.bytes);
+    }
+    out << "# TYPE stdx_scan_failures_total counter\n";
+    for (const auto& counters : snapshots) {
+        series("stdx_scan_failures_total", counters, ",stage=\"literal\"", counters.literal_failures);
+        for (std::size_t i = 0; i < counters.fields.size(); ++i) {
+            const std::string field = ",field=\"" + std::to_string(i) + "\"";
+            for (std::size_t stage = 0; stage < 2; ++stage) {
+                const std::string_view stage_name = stage == 0 ? "separator" : "conversion";
+                for (std::size_t reason = 0; reason < details::ERROR_REASON_COUNT; ++reason) {
+                    if (const auto count = counters.fields[i].reasons[stage][reason]; count != 0) {
+                        const auto name = details::error_reason_name(static_cast<details::error_reason>(reason));
+                        series("stdx_scan_failures_total", counters,
+                               field + ",stage=\"" + std::string(stage_name) + "\",reason=\"" + std::string(name) + "\"",
+                               count);
+                    }
+                }
+            }
+        }
+    }
+    out << "# TYPE stdx_scan_sampled_lines_total counter\n";
+    for (const auto& counters : snapshots) {
+        series("stdx_scan_sampled_lines_total", counters, "", counters.sampled);
+    }
+    out << "# TYPE stdx_scan_stage_cycles_total counter\n";
+    for (const auto& counters : snapshots) {
+        series("stdx_scan_stage_cycles_total", counters, ",stage=\"separator\"", counters.separator_cycles);
+        series("stdx_scan_stage_cycles_total", counters, ",stage=\"conversion\"", counters.conversion_cycles);
+    }
+}
+
+} // namespace stdx
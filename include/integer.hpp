@@ -0,0 +1,292 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include "types.hpp"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace stdx::details {
+
+// Минимальная разрядность типа, начиная с которой разбор в runtime векторизуется
+constinit const std::size_t VECTORIZED_MIN_DIGITS = 16;
+
+// Максимальное число значащих десятичных цифр беззнакового типа
+template <std::unsigned_integral U>
+constexpr std::size_t max_decimal_digits = std::numeric_limits<U>::digits10 + 1;
+
+constexpr bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Скалярный разбор за один проход: подсчёт цифр и накопление значения, не превышающего limit.
+// Возвращает длину последовательности цифр, при выходе значения за limit выставляет overflow.
+// Если MaxLimit * 10 помещается в uint64_t, переполнение проверяется сравнением без деления
+template <std::uint64_t MaxLimit>
+constexpr std::size_t accumulate_digits(const char* p, const char* end, std::uint64_t limit, std::uint64_t& value,
+                                        bool& overflow) {
+    constexpr bool narrow = MaxLimit < std::numeric_limits<std::uint64_t>::max() / 10 - 9;
+    const char* begin = p;
+    for (; p != end && is_digit(*p); ++p) {
+        if (overflow) {
+            continue;
+        }
+        const auto digit = static_cast<std::uint64_t>(*p - '0');
+        if constexpr (narrow) {
+            value = value * 10 + digit;
+            overflow = value > limit;
+        } else if (value > (limit - digit) / 10) {
+            overflow = true;
+        } else {
+            value = value * 10 + digit;
+        }
+    }
+    return static_cast<std::size_t>(p - begin);
+}
+
+// Скалярный поиск длины последовательности цифр
+constexpr std::size_t count_digits(const char* p, const char* end) {
+    const char* begin = p;
+    while (p != end && is_digit(*p)) {
+        ++p;
+    }
+    return static_cast<std::size_t>(p - begin);
+}
+
+namespace swar {
+
+constexpr bool available = std::endian::native == std::endian::little;
+
+inline std::uint64_t load8(const char* p) {
+    std::uint64_t chunk;
+    std::memcpy(&chunk, p, sizeof(chunk));
+    return chunk;
+}
+
+// Проверка, что все 8 байт являются цифрами
+inline bool all_digits8(std::uint64_t chunk) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0) | (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+           0x3333333333333333;
+}
+
+// Преобразование 8 цифр за три умножения: пары, четвёрки, восьмёрки
+inline std::uint64_t convert8(std::uint64_t chunk) {
+    chunk = (chunk & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+    chunk = (chunk & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+    return (chunk & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+}
+
+} // namespace swar
+
+#if defined(__SSE2__)
+namespace sse {
+
+// Маска позиций байтов, не являющихся цифрами, в блоке из 16 байт
+inline std::uint32_t non_digit_mask16(const char* p) {
+    const __m128i chunk = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+    const __m128i outside = _mm_or_si128(_mm_cmplt_epi8(chunk, _mm_setzero_si128()),
+                                         _mm_cmpgt_epi8(chunk, _mm_set1_epi8(9)));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(outside));
+}
+
+#if defined(__SSSE3__)
+// Преобразование 16 проверенных цифр: пары через maddubs, четвёрки и восьмёрки через madd
+inline std::uint64_t convert16(const char* p) {
+    const __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+    const __m128i pairs =
+        _mm_maddubs_epi16(digits, _mm_set_epi8(1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10));
+    const __m128i quads = _mm_madd_epi16(pairs, _mm_set_epi16(1, 100, 1, 100, 1, 100, 1, 100));
+    const __m128i packed = _mm_packs_epi32(quads, quads);
+    const __m128i octets = _mm_madd_epi16(packed, _mm_set_epi16(1, 10000, 1, 10000, 1, 10000, 1, 10000));
+    const auto high = static_cast<std::uint32_t>(_mm_cvtsi128_si32(octets));
+    const auto low = static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(octets, 4)));
+    return static_cast<std::uint64_t>(high) * 100000000 + low;
+}
+#endif
+
+} // namespace sse
+#endif
+
+// Векторизованный поиск длины последовательности цифр
+inline std::size_t count_digits_simd(const char* p, const char* end) {
+    const char* begin = p;
+#if defined(__SSE2__)
+    while (end - p >= 16) {
+        const std::uint32_t mask = sse::non_digit_mask16(p);
+        if (mask != 0) {
+            return static_cast<std::size_t>(p - begin) + std::countr_zero(mask);
+        }
+        p += 16;
+    }
+#endif
+    if constexpr (swar::available) {
+        while (end - p >= 8 && swar::all_digits8(swar::load8(p))) {
+            p += 8;
+        }
+    }
+    return static_cast<std::size_t>(p - begin) + count_digits(p, end);
+}
+
+// Векторизованное накопление значения из count проверенных цифр, count не превышает 19
+inline std::uint64_t convert_digits_simd(const char* p, std::size_t count) {
+    std::uint64_t value = 0;
+#if defined(__SSSE3__)
+    if (count >= 16) {
+        value = sse::convert16(p);
+        p += 16;
+        count -= 16;
+    }
+#endif
+    if constexpr (swar::available) {
+        while (count >= 8) {
+            value = value * 100000000 + swar::convert8(swar::load8(p));
+            p += 8;
+            count -= 8;
+        }
+    }
+    for (; count > 0; --count, ++p) {
+        value = value * 10 + static_cast<std::uint64_t>(*p - '0');
+    }
+    return value;
+}
+
+// Векторизованный разбор для типов от 32 бит: поиск конца цифр блоками, затем накопление SWAR/SSE
+inline std::size_t accumulate_digits_simd(const char* p, const char* end, std::uint64_t limit, std::uint64_t& value,
+                                          bool& overflow) {
+    const std::size_t length = count_digits_simd(p, end);
+    const char* const digits_end = p + length;
+
+    // Ведущие нули не влияют на значение
+    while (p != digits_end && *p == '0') {
+        ++p;
+    }
+    const auto significant = static_cast<std::size_t>(digits_end - p);
+    if (significant > max_decimal_digits<std::uint64_t>) {
+        overflow = true;
+        return length;
+    }
+
+    // Последняя цифра 20-значного числа добавляется с проверкой переполнения uint64_t
+    const std::size_t unchecked = significant < 20 ? significant : 19;
+    value = convert_digits_simd(p, unchecked);
+    if (significant == 20) {
+        accumulate_digits<std::numeric_limits<std::uint64_t>::max()>(p + unchecked, digits_end, limit, value, overflow);
+    }
+    overflow = overflow || value > limit;
+    return length;
+}
+
+// Разбор целого числа с проверками переполнения и лишних символов, как у std::from_chars.
+// В compile-time и для типов до 16 бит используется скалярный алгоритм, в runtime для остальных - SWAR/SSE
+template <std::integral T>
+constexpr std::expected<T, parse_error> parse_integer(std::string_view str) {
+    using BaseType = std::remove_cv_t<T>;
+    using UnsignedType = std::make_unsigned_t<BaseType>;
+    constexpr bool vectorized = max_decimal_digits<UnsignedType> >= VECTORIZED_MIN_DIGITS;
+
+    const char* p = str.data();
+    const char* const end = p + str.size();
+
+    bool negative = false;
+    if constexpr (std::is_signed_v<BaseType>) {
+        if (p != end && *p == '-') {
+            negative = true;
+            ++p;
+        }
+    }
+
+    // Модуль отрицательного числа может быть на единицу больше максимума типа
+    constexpr auto max_value = static_cast<std::uint64_t>(std::numeric_limits<BaseType>::max());
+    constexpr auto max_limit = max_value + (std::is_signed_v<BaseType> ? 1 : 0);
+    const std::uint64_t limit = max_value + (negative ? 1 : 0);
+
+    std::uint64_t value = 0;
+    bool overflow = false;
+    std::size_t length = 0;
+    if consteval {
+        length = accumulate_digits<max_limit>(p, end, limit, value, overflow);
+    } else {
+        if constexpr (vectorized) {
+            length = accumulate_digits_simd(p, end, limit, value, overflow);
+        } else {
+            length = accumulate_digits<max_limit>(p, end, limit, value, overflow);
+        }
+    }
+
+    if (length == 0) {
+        return std::unexpected(parse_error{"Failed to parse integer", error_reason::syntax});
+    }
+    if (overflow) {
+        return std::unexpected(parse_error{"Failed to parse integer", error_reason::overflow});
+    }
+
+    if (p + length != end) {
+        return std::unexpected(parse_error{"Extra characters after integer", error_reason::extra});
+    }
+
+    const auto magnitude = static_cast<UnsignedType>(value);
+    return static_cast<BaseType>(negative ? static_cast<UnsignedType>(0 - magnitude) : magnitude);
+}
+
+// Проверка, что строка является целым числом, без преобразования и без проверки диапазона:
+// необязательный '-' для знаковых значений и непустая последовательность цифр
+template <bool Signed>
+constexpr bool is_integer_text(std::string_view str) {
+    if (Signed && str.starts_with('-')) {
+        str.remove_prefix(1);
+    }
+    const char* const end = str.data() + str.size();
+    if consteval {
+        return !str.empty() && count_digits(str.data(), end) == str.size();
+    } else {
+        return !str.empty() && count_digits_simd(str.data(), end) == str.size();
+    }
+}
+
+// Разбор поля фиксированной ширины Width. Поле из одних цифр, значение которого заведомо помещается в тип,
+// преобразуется без поиска конца числа и без проверок переполнения, в runtime - блоками по 8 цифр.
+// Поля со знаком или дополненные пробелами до ширины разбираются parse_integer после отбрасывания пробелов
+template <std::integral T, std::size_t Width>
+constexpr std::expected<T, parse_error> parse_fixed_integer(std::string_view field) {
+    using BaseType = std::remove_cv_t<T>;
+
+    if constexpr (Width <= static_cast<std::size_t>(std::numeric_limits<BaseType>::digits10)) {
+        const char* const p = field.data();
+        std::uint64_t value = 0;
+        bool digits = field.size() == Width;
+        std::size_t i = 0;
+        if !consteval {
+            if constexpr (swar::available) {
+                for (; digits && i + 8 <= Width; i += 8) {
+                    const std::uint64_t chunk = swar::load8(p + i);
+                    digits = swar::all_digits8(chunk);
+                    value = value * 100000000 + swar::convert8(chunk);
+                }
+            }
+        }
+        for (; digits && i < Width; ++i) {
+            digits = is_digit(p[i]);
+            value = value * 10 + static_cast<std::uint64_t>(p[i] - '0');
+        }
+        if (digits) {
+            return static_cast<BaseType>(value);
+        }
+    }
+
+    const std::size_t first = field.find_first_not_of(' ');
+    if (first == std::string_view::npos) {
+        return std::unexpected(parse_error{"Failed to parse integer", error_reason::syntax});
+    }
+    return parse_integer<T>(field.substr(first, field.find_last_not_of(' ') + 1 - first));
+}
+
+} // namespace stdx::details
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+#include <type_traits>
+#include "types.hpp"
+
+namespace stdx {
+
+// Написание ключевого слова и соответствующее ему значение перечисления
+template <typename Enum>
+struct keyword {
+    std::string_view spelling;
+    Enum value;
+};
+
+// Список ключевых слов перечисления Enum для плейсхолдера {%k}. Пользователь специализирует шаблон:
+// template <> struct stdx::keywords<level> {
+//     static constexpr std::array entries = {stdx::keyword{"info", level::info}, stdx::keyword{"warn", level::warn}};
+// };
+template <typename Enum>
+struct keywords;
+
+} // namespace stdx
+
+namespace stdx::details {
+
+template <typename T>
+concept SupportedKeywordType =
+    std::is_enum_v<std::remove_cv_t<T>> && requires { stdx::keywords<std::remove_cv_t<T>>::entries; };
+
+// Наибольшее число затравок, перебираемых для одного размера таблицы
+constexpr std::uint64_t KEYWORD_MAX_SEEDS = 4096;
+
+// Способ хеширования: по длине и трём символам за постоянное время или по всем символам строки.
+// Второй используется, только если ключевые слова не различаются по первому, среднему и последнему символам
+enum class keyword_hash_kind { sampled, full };
+
+template <keyword_hash_kind Kind>
+constexpr std::uint64_t keyword_hash(std::string_view str, std::uint64_t seed) {
+    std::uint64_t hash = seed;
+    if constexpr (Kind == keyword_hash_kind::sampled) {
+        const auto at = [&](std::size_t i) { return static_cast<std::uint64_t>(static_cast<unsigned char>(str[i])); };
+        hash ^= str.size() | at(0) << 8 | at(str.size() / 2) << 16 | at(str.size() - 1) << 24;
+        hash *= 0x9E3779B97F4A7C15;
+    } else {
+        for (const char c : str) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001B3;
+        }
+    }
+    return hash ^ (hash >> 29);
+}
+
+// Параметры совершенного хеша: размер таблицы (степень двойки) и затравка, size == 0 - хеш не найден
+struct keyword_hash_params {
+    keyword_hash_kind kind = keyword_hash_kind::sampled;
+    std::size_t size = 0;
+    std::uint64_t seed = 0;
+};
+
+// Наибольший размер таблицы: 8 * bit_ceil(255) ячеек
+constexpr std::size_t KEYWORD_MAX_TABLE_SIZE = 2048;
+
+// Проверяет, что хеш с данной затравкой не даёт коллизий на таблице размера size
+template <keyword_hash_kind Kind, typename Enum, std::size_t N>
+consteval bool is_perfect_hash(const std::array<keyword<Enum>, N>& entries, std::size_t size, std::uint64_t seed) {
+    std::array<std::uint64_t, KEYWORD_MAX_TABLE_SIZE / 64> used{};
+    for (const auto& entry : entries) {
+        const std::size_t slot = keyword_hash<Kind>(entry.spelling, seed) & (size - 1);
+        const std::uint64_t bit = std::uint64_t{1} << (slot % 64);
+        if (used[slot / 64] & bit) {
+            return false;
+        }
+        used[slot / 64] |= bit;
+    }
+    return true;
+}
+
+// Различаются ли слова по длине, первому, среднему и последнему символам: иначе выборочный хеш невозможен
+template <typename Enum, std::size_t N>
+consteval bool has_distinct_samples(const std::array<keyword<Enum>, N>& entries) {
+    const auto sample = [](std::string_view str) {
+        return keyword_hash<keyword_hash_kind::sampled>(str, 0);
+    };
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            if (sample(entries[i].spelling) == sample(entries[j].spelling)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <keyword_hash_kind Kind, typename Enum, std::size_t N>
+consteval keyword_hash_params find_perfect_hash(const std::array<keyword<Enum>, N>& entries) {
+    if (Kind == keyword_hash_kind::sampled && !has_distinct_samples(entries)) {
+        return {};
+    }
+    // Начиная с наименьшей таблицы, вмещающей все слова; большие таблицы ускоряют поиск затравки
+    for (std::size_t size = std::bit_ceil(N); size <= 8 * std::bit_ceil(N); size *= 2) {
+        for (std::uint64_t seed = 1; seed <= KEYWORD_MAX_SEEDS; ++seed) {
+            if (is_perfect_hash<Kind>(entries, size, seed)) {
+                return {Kind, size, seed};
+            }
+        }
+    }
+    return {};
+}
+
+// Таблица ключевых слов перечисления Enum с совершенным хешем, построенная в compile-time:
+// поиск - одно хеширование и одно сравнение строк
+template <typename Enum>
+struct keyword_table {
+    static constexpr auto& entries = stdx::keywords<Enum>::entries;
+
+    static consteval bool valid_entries() {
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            if (entries[i].spelling.empty()) {
+                return false;
+            }
+            for (std::size_t j = 0; j < i; ++j) {
+                if (entries[i].spelling == entries[j].spelling) {
+                    return false;
+                }
+            }
+        }
+        return !entries.empty();
+    }
+    static_assert(valid_entries(), "Keyword spellings must be non-empty and unique");
+
+    static consteval keyword_hash_params find_params() {
+        const auto sampled = find_perfect_hash<keyword_hash_kind::sampled>(entries);
+        return sampled.size != 0 ? sampled : find_perfect_hash<keyword_hash_kind::full>(entries);
+    }
+
+    static constexpr keyword_hash_params params = find_params();
+    static constexpr keyword_hash_kind kind = params.kind;
+    static_assert(params.size != 0, "Perfect hash for keywords hasn't been found");
+    static_assert(entries.size() < 256, "Too many keywords");
+
+    // Номер слова в entries, увеличенный на единицу, для каждой ячейки; 0 - пустая ячейка
+    static constexpr auto slots = [] {
+        std::array<std::uint8_t, params.size> result{};
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            result[keyword_hash<kind>(entries[i].spelling, params.seed) & (params.size - 1)] =
+                static_cast<std::uint8_t>(i + 1);
+        }
+        return result;
+    }();
+
+    static constexpr std::expected<Enum, parse_error> find(std::string_view str) {
+        if (str.empty()) {
+            return std::unexpected(parse_error{"Unknown keyword", error_reason::keyword});
+        }
+        const std::size_t index = slots[keyword_hash<kind>(str, params.seed) & (params.size - 1)];
+        if (index == 0 || entries[index - 1].spelling != str) {
+            return std::unexpected(parse_error{"Unknown keyword", error_reason::keyword});
+        }
+        return entries[index - 1].value;
+    }
+};
+
+// Разбор ключевого слова в значение перечисления
+template <SupportedKeywordType T>
+constexpr std::expected<T, parse_error> parse_keyword(std::string_view str) {
+    return keyword_table<std::remove_cv_t<T>>::find(str);
+}
+
+} // namespace stdx::details
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "format_string.hpp"
+#include "parse.hpp"
+#include "types.hpp"
+
+namespace stdx::details {
+
+// Результат ленивого разбора: при сканировании находятся только границы полей,
+// значение поля преобразуется при первом обращении через get<I>() и запоминается.
+// Хранит ссылку на исходную строку, поэтому строка должна жить дольше результата
+template <auto Fmt, SupportedScanType... Ts>
+class lazy_scan_result {
+    static_assert(sizeof...(Ts) <= 64, "Lazy scan supports at most 64 placeholders");
+
+public:
+    template <std::size_t I>
+    using value_type = std::remove_cv_t<std::tuple_element_t<I, std::tuple<Ts...>>>;
+
+    // Поиск границ всех полей за один проход по плану формата, как в parse_into, но без преобразования значений:
+    // ошибки преобразования откладываются до get<I>(), соответствие типов спецификаторам проверяется сразу
+    static constexpr std::expected<lazy_scan_result, parse_error> locate(std::string_view src) {
+        lazy_scan_result result;
+        result.source_ = src;
+        if (const auto error = parse_into<Fmt, Ts...>(src, result.bounds_)) {
+            return std::unexpected(*error);
+        }
+        return result;
+    }
+
+    // Значение I-го поля: преобразуется при первом успешном обращении и запоминается,
+    // ошибка преобразования не запоминается
+    template <std::size_t I>
+    constexpr std::expected<value_type<I>, parse_error> get() {
+        static_assert(I < sizeof...(Ts), "Invalid placeholder index");
+        constexpr std::uint64_t bit = std::uint64_t{1} << I;
+        if (parsed_ & bit) {
+            return std::get<I>(values_);
+        }
+        using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+        constexpr std::size_t index = Fmt.plan.arguments[I];
+        constexpr placeholder current = Fmt.plan.placeholders[index];
+
+        auto value = parse_value<T, current.width, current.specifier>(bounds_.fields[I]);
+        if (value) {
+            std::get<I>(values_) = *value;
+            parsed_ |= bit;
+        }
+        return value;
+    }
+
+    // Значение I-го поля без запоминания: константный результат не изменяется
+    template <std::size_t I>
+    constexpr std::expected<value_type<I>, parse_error> get() const {
+        static_assert(I < sizeof...(Ts), "Invalid placeholder index");
+        using T = std::tuple_element_t<I, std::tuple<Ts...>>;
+        constexpr std::size_t index = Fmt.plan.arguments[I];
+        constexpr placeholder current = Fmt.plan.placeholders[index];
+
+        if (parsed_ & (std::uint64_t{1} << I)) {
+            return std::get<I>(values_);
+        }
+        return parse_value<T, current.width, current.specifier>(bounds_.fields[I]);
+    }
+
+    // Исходный текст I-го поля без преобразования
+    template <std::size_t I>
+    constexpr std::string_view field() const {
+        static_assert(I < sizeof...(Ts), "Invalid placeholder index");
+        return bounds_.fields[I];
+    }
+
+    constexpr std::string_view source() const { return source_; }
+
+private:
+    constexpr lazy_scan_result() = default;
+
+    std::string_view source_;
+    field_bounds<sizeof...(Ts)> bounds_;
+    std::tuple<std::remove_cv_t<Ts>...> values_{};
+    std::uint64_t parsed_ = 0;
+};
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Ленивая runtime-версия scan: проверяет литералы и находит границы полей,
+// а значения преобразует только для тех полей, к которым обращаются через get<I>()
+template <details::format_string fmt, typename... Ts>
+constexpr std::expected<details::lazy_scan_result<fmt, Ts...>, details::parse_error> scan_lazy(std::string_view input) {
+    static_assert(fmt.number_arguments == sizeof...(Ts),
+        "Number of placeholders must match number of types");
+
+    return details::lazy_scan_result<fmt, Ts...>::locate(input);
+}
+
+} // namespace stdx
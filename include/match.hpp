@@ -0,0 +1,322 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "file.hpp"
+#include "format_string.hpp"
+#include "parse.hpp"
+#include "types.hpp"
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace stdx::details {
+
+// Упакованный битовый массив результатов match: бит i равен 1, если i-я строка соответствует формату
+class match_bitmap {
+public:
+    std::size_t size() const { return size_; }
+
+    bool test(std::size_t i) const { return (words_[i / 64] >> (i % 64)) & 1; }
+
+    // Число строк, соответствующих формату
+    std::size_t count() const {
+        std::size_t result = 0;
+        for (const std::uint64_t word : words_) {
+            result += static_cast<std::size_t>(std::popcount(word));
+        }
+        return result;
+    }
+
+    // Слова битового массива, бит i лежит в words()[i / 64] на позиции i % 64
+    std::span<const std::uint64_t> words() const { return words_; }
+
+    // Дописывает count младших бит bits, count не больше 64, старшие биты bits должны быть нулевыми
+    void append(std::uint64_t bits, std::size_t count) {
+        if (count == 0) {
+            return;
+        }
+        const std::size_t offset = size_ % 64;
+        if (offset == 0) {
+            words_.push_back(0);
+        }
+        words_.back() |= bits << offset;
+        if (offset + count > 64) {
+            words_.push_back(bits >> (64 - offset));
+        }
+        size_ += count;
+    }
+
+private:
+    std::vector<std::uint64_t> words_;
+    std::size_t size_ = 0;
+};
+
+// Проверка строки на соответствие формату без преобразования значений: литералы и форма полей
+template <auto Fmt>
+constexpr bool match_line(std::string_view src) {
+    if constexpr (Fmt.plan.fixed) {
+        if (check_fixed_record<Fmt>(src)) {
+            return false;
+        }
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return (check_field_shape<Fmt, Is>(src.substr(Fmt.plan.offsets[Is], Fmt.plan.placeholders[Is].width)) &&
+                    ...);
+        }(std::make_index_sequence<Fmt.number_placeholders>{});
+    }
+
+    constexpr auto prefix = get_literal<Fmt, 0>();
+    if (!src.starts_with(prefix)) {
+        return false;
+    }
+
+    if constexpr (Fmt.number_placeholders == 0) {
+        return src.size() == prefix.size();
+    } else {
+        std::size_t pos = prefix.size();
+        return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            return ([&] {
+                const auto field = find_field<Is, Fmt>(src, pos);
+                return field && check_field_shape<Fmt, Is>(*field);
+            }() && ...);
+        }(std::make_index_sequence<Fmt.number_placeholders>{});
+    }
+}
+
+// Форма поля проверяется по отдельным байтам: %d и %u - цифры, %s, %k и поля без спецификатора - любые байты.
+// Поля %d и %u со знаком или пробелами не проходят побайтовую проверку и проверяются скалярно
+constexpr bool is_bytewise_shape(char spec) {
+    return spec != 'x' && spec != 'o' && spec != 'b' && spec != 'f';
+}
+
+// Ширина блока векторной проверки записей фиксированной длины, 0 - векторная проверка недоступна
+#if defined(__AVX2__)
+constexpr std::size_t MATCH_WINDOW = 32;
+#elif defined(__SSE2__)
+constexpr std::size_t MATCH_WINDOW = 16;
+#else
+constexpr std::size_t MATCH_WINDOW = 0;
+#endif
+
+// Запись формата Fmt делится на строки так же, как буфер: литералы не содержат '\n' и не оканчивают запись '\r'
+template <auto Fmt>
+consteval bool is_single_line_record() {
+    const auto tail = Fmt.plan.literals[Fmt.number_placeholders];
+    if (tail.length != 0 && Fmt.source.data[tail.offset + tail.length - 1] == '\r') {
+        return false;
+    }
+    for (const auto literal : Fmt.plan.literals) {
+        for (std::size_t j = 0; j < literal.length; ++j) {
+            if (Fmt.source.data[literal.offset + j] == '\n') {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Шаблоны байтов блока из нескольких подряд идущих записей фиксированной длины, разделённых '\n':
+// ожидаемые литералы, маска позиций литералов, маска позиций цифр и маски позиций остальных полей, где не должно
+// быть '\n' и, в конце записи, '\r' - иначе скалярная проверка разделила бы строки по-другому. Поля %x, %o, %b
+// и %f проверяются скалярно уже после того, как блок разделён на записи, поэтому охраняются так же, как %s
+template <auto Fmt>
+struct match_layout {
+    static constexpr std::size_t stride = Fmt.plan.record_size + 1;
+    static constexpr std::size_t records =
+        (MATCH_WINDOW != 0 && stride <= MATCH_WINDOW && is_single_line_record<Fmt>()) ? MATCH_WINDOW / stride : 0;
+
+    struct masks {
+        std::array<std::uint8_t, MATCH_WINDOW> literal{};
+        std::array<std::uint8_t, MATCH_WINDOW> literal_mask{};
+        std::array<std::uint8_t, MATCH_WINDOW> digit_mask{};
+        std::array<std::uint8_t, MATCH_WINDOW> newline_mask{};
+        std::array<std::uint8_t, MATCH_WINDOW> return_mask{};
+    };
+
+    static consteval masks build() {
+        masks result;
+        for (std::size_t record = 0; record < records; ++record) {
+            const std::size_t base = record * stride;
+            std::size_t position = 0;
+            for (std::size_t i = 0; i <= Fmt.number_placeholders; ++i) {
+                const auto literal = Fmt.plan.literals[i];
+                for (std::size_t j = 0; j < literal.length; ++j) {
+                    result.literal[base + position + j] = static_cast<std::uint8_t>(Fmt.source.data[literal.offset + j]);
+                    result.literal_mask[base + position + j] = 0xFF;
+                }
+                if (i == Fmt.number_placeholders) {
+                    break;
+                }
+                const placeholder current = Fmt.plan.placeholders[i];
+                position = Fmt.plan.offsets[i];
+                if (current.specifier == 'd' || current.specifier == 'u') {
+                    for (std::size_t j = 0; j < current.width; ++j) {
+                        result.digit_mask[base + position + j] = 0xFF;
+                    }
+                } else {
+                    for (std::size_t j = 0; j < current.width; ++j) {
+                        result.newline_mask[base + position + j] = 0xFF;
+                    }
+                    if (position + current.width == Fmt.plan.record_size) {
+                        result.return_mask[base + position + current.width - 1] = 0xFF;
+                    }
+                }
+                position += current.width;
+            }
+            result.literal[base + stride - 1] = '\n';
+            result.literal_mask[base + stride - 1] = 0xFF;
+        }
+        return result;
+    }
+
+    static constexpr masks patterns = build();
+};
+
+// Поля записи фиксированной длины, форму которых нельзя проверить по отдельным байтам
+template <auto Fmt>
+constexpr bool check_deferred_fields(std::string_view record) {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        return ([&] {
+            if constexpr (is_bytewise_shape(Fmt.plan.placeholders[Is].specifier)) {
+                return true;
+            } else {
+                return check_field_shape<Fmt, Is>(record.substr(Fmt.plan.offsets[Is], Fmt.plan.placeholders[Is].width));
+            }
+        }() && ...);
+    }(std::make_index_sequence<Fmt.number_placeholders>{});
+}
+
+// Маска байтов блока, не прошедших проверку: литерал не совпал, на месте цифры стоит не цифра
+// или в поле с любыми байтами стоит разделитель строк
+template <auto Fmt>
+inline std::uint64_t match_fail_mask(const char* p) {
+    constexpr auto& patterns = match_layout<Fmt>::patterns;
+#if defined(__AVX2__)
+    const auto load = [](const void* data) { return _mm256_loadu_si256(static_cast<const __m256i*>(data)); };
+    const __m256i block = load(p);
+    const __m256i literal_fail =
+        _mm256_andnot_si256(_mm256_cmpeq_epi8(block, load(patterns.literal.data())), load(patterns.literal_mask.data()));
+    const __m256i digits = _mm256_sub_epi8(block, _mm256_set1_epi8('0'));
+    const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+    const __m256i digit_fail = _mm256_andnot_si256(is_digit, load(patterns.digit_mask.data()));
+    const auto separator = [&](char byte, const auto& mask) {
+        return _mm256_and_si256(_mm256_cmpeq_epi8(block, _mm256_set1_epi8(byte)), load(mask.data()));
+    };
+    const __m256i separator_fail =
+        _mm256_or_si256(separator('\n', patterns.newline_mask), separator('\r', patterns.return_mask));
+    return static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(literal_fail, digit_fail), separator_fail)));
+#elif defined(__SSE2__)
+    const auto load = [](const void* data) { return _mm_loadu_si128(static_cast<const __m128i*>(data)); };
+    const __m128i block = load(p);
+    const __m128i literal_fail =
+        _mm_andnot_si128(_mm_cmpeq_epi8(block, load(patterns.literal.data())), load(patterns.literal_mask.data()));
+    const __m128i digits = _mm_sub_epi8(block, _mm_set1_epi8('0'));
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+    const __m128i digit_fail = _mm_andnot_si128(is_digit, load(patterns.digit_mask.data()));
+    const auto separator = [&](char byte, const auto& mask) {
+        return _mm_and_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(byte)), load(mask.data()));
+    };
+    const __m128i separator_fail = _mm_or_si128(separator('\n', patterns.newline_mask), separator('\r', patterns.return_mask));
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(literal_fail, digit_fail), separator_fail)));
+#else
+    (void)p;
+    (void)patterns;
+    return ~std::uint64_t{0};
+#endif
+}
+
+// Проверяет одну строку буфера, начинающуюся с позиции begin, и возвращает позицию следующей строки
+template <auto Fmt>
+std::size_t match_next_line(std::string_view buffer, std::size_t begin, match_bitmap& bitmap) {
+    const std::size_t newline = buffer.find('\n', begin);
+    const std::size_t end = (newline == std::string_view::npos) ? buffer.size() : newline;
+    auto line = buffer.substr(begin, end - begin);
+    if (line.ends_with('\r')) {
+        line.remove_suffix(1);
+    }
+    bitmap.append(match_line<Fmt>(line) ? 1 : 0, 1);
+    return end + 1;
+}
+
+// Проверка строк буфера по формату Fmt. Записи фиксированной длины, из которых в блок SIMD помещается
+// несколько, проверяются по несколько за шаг: литералы, '\n' и цифровые поля сравниваются с шаблоном блока.
+// Строки, не прошедшие векторную проверку (другая длина, '\r', знак или пробелы в числе), проверяются скалярно
+template <auto Fmt>
+void match_buffer(std::string_view buffer, match_bitmap& bitmap) {
+    using layout = match_layout<Fmt>;
+    std::size_t begin = 0;
+    if constexpr (Fmt.plan.fixed && layout::records > 0) {
+        constexpr std::uint64_t record_bits = (std::uint64_t{1} << layout::stride) - 1;
+        // После строки без завершающего '\n' begin равен buffer.size() + 1
+        while (begin < buffer.size() && buffer.size() - begin >= MATCH_WINDOW) {
+            const std::uint64_t fail = match_fail_mask<Fmt>(buffer.data() + begin);
+            std::size_t passed = 0;
+            std::uint64_t bits = 0;
+            for (; passed < layout::records && ((fail >> (passed * layout::stride)) & record_bits) == 0; ++passed) {
+                const auto record = buffer.substr(begin + passed * layout::stride, Fmt.plan.record_size);
+                bits |= static_cast<std::uint64_t>(check_deferred_fields<Fmt>(record)) << passed;
+            }
+            bitmap.append(bits, passed);
+            begin += passed * layout::stride;
+            if (passed < layout::records) {
+                begin = match_next_line<Fmt>(buffer, begin, bitmap);
+            }
+        }
+    }
+    while (begin < buffer.size()) {
+        begin = match_next_line<Fmt>(buffer, begin, bitmap);
+    }
+}
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Проверяет каждую строку буфера на соответствие формату fmt без преобразования значений:
+// сравниваются литералы и форма полей (%d, %u, %x, %o, %b, %f), переполнение типа не проверяется.
+// Бит i результата соответствует i-й строке буфера, завершающий '\r' строки отбрасывается
+template <details::format_string fmt>
+details::match_bitmap match(std::string_view buffer) {
+    details::match_bitmap bitmap;
+    details::match_buffer<fmt>(buffer, bitmap);
+    return bitmap;
+}
+
+// Проверяет строки lines на соответствие формату fmt, бит i результата соответствует lines[i]
+template <details::format_string fmt>
+details::match_bitmap match(std::span<const std::string_view> lines) {
+    details::match_bitmap bitmap;
+    for (std::size_t i = 0; i < lines.size(); i += 64) {
+        const std::size_t count = lines.size() - i < 64 ? lines.size() - i : 64;
+        std::uint64_t bits = 0;
+        for (std::size_t j = 0; j < count; ++j) {
+            bits |= static_cast<std::uint64_t>(details::match_line<fmt>(lines[i + j])) << j;
+        }
+        bitmap.append(bits, count);
+    }
+    return bitmap;
+}
+
+// Отображает файл в память и проверяет каждую его строку на соответствие формату fmt
+template <details::format_string fmt>
+std::expected<details::match_bitmap, std::error_code> match_file(const std::filesystem::path& path) {
+    auto file = details::mapped_file::open(path);
+    if (!file) {
+        return std::unexpected(file.error());
+    }
+    return match<fmt>(file->view());
+}
+
+} // namespace stdx
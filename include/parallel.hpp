@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <expected>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "file.hpp"
+#include "format_string.hpp"
+#include "scan.hpp"
+#include "search.hpp"
+#include "types.hpp"
+
+namespace stdx::details {
+
+// Порядок, в котором объединяются результаты потоков
+enum class merge_order {
+    input,     // как при последовательном разборе
+    unordered  // записи каждого потока подряд, потоки по порядку номеров, без промежуточных буферов на каждый кусок
+};
+
+// Параметры параллельного разбора
+struct parallel_options {
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t chunk_size = std::size_t{4} << 20;
+    merge_order order = merge_order::input;
+};
+
+// Результаты пакетного разбора
+template <typename... Ts>
+struct bulk_result {
+    std::vector<scan_result<Ts...>> records;
+    scan_stats stats;
+};
+
+// Результаты пакетного разбора файла вместе с отображением, на которое указывают строковые значения
+template <typename... Ts>
+struct mapped_bulk_result : bulk_result<Ts...> {
+    mapped_file file;
+};
+
+// Делит буфер на куски размером около chunk_size, границы кусков совпадают с началами строк
+inline std::vector<std::string_view> split_chunks(std::string_view buffer, std::size_t chunk_size) {
+    std::vector<std::string_view> chunks;
+    chunk_size = std::max<std::size_t>(chunk_size, 1);
+
+    std::size_t begin = 0;
+    while (begin < buffer.size()) {
+        std::size_t end = buffer.size();
+        if (buffer.size() - begin > chunk_size) {
+            const std::size_t newline = literal_searcher<fixed_string{"\n"}>::find(buffer, begin + chunk_size - 1);
+            end = (newline == std::string_view::npos) ? buffer.size() : newline + 1;
+        }
+        chunks.push_back(buffer.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+}
+
+// Очередь задач одного потока: владелец берёт задачи с начала, остальные потоки крадут с конца
+class task_queue {
+public:
+    void push(std::size_t task) {
+        std::lock_guard lock(mutex_);
+        tasks_.push_back(task);
+    }
+
+    std::optional<std::size_t> pop() {
+        std::lock_guard lock(mutex_);
+        if (tasks_.empty()) {
+            return std::nullopt;
+        }
+        const std::size_t task = tasks_.front();
+        tasks_.pop_front();
+        return task;
+    }
+
+    std::optional<std::size_t> steal() {
+        std::lock_guard lock(mutex_);
+        if (tasks_.empty()) {
+            return std::nullopt;
+        }
+        const std::size_t task = tasks_.back();
+        tasks_.pop_back();
+        return task;
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<std::size_t> tasks_;
+};
+
+// Выполняет run(worker, task) для задач [0, tasks) на workers потоках с кражей работы.
+// Каждый поток изначально получает непрерывный диапазон задач, вызывающий поток работает как поток 0
+template <typename F>
+void run_work_stealing(std::size_t workers, std::size_t tasks, F&& run) {
+    workers = std::clamp<std::size_t>(workers, 1, std::max<std::size_t>(tasks, 1));
+    std::vector<task_queue> queues(workers);
+    for (std::size_t w = 0; w < workers; ++w) {
+        for (std::size_t task = tasks * w / workers; task < tasks * (w + 1) / workers; ++task) {
+            queues[w].push(task);
+        }
+    }
+
+    const auto work = [&](std::size_t worker) {
+        while (true) {
+            auto task = queues[worker].pop();
+            for (std::size_t shift = 1; !task && shift < workers; ++shift) {
+                task = queues[(worker + shift) % workers].steal();
+            }
+            if (!task) {
+                return;
+            }
+            run(worker, *task);
+        }
+    };
+
+    std::vector<std::jthread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t w = 1; w < workers; ++w) {
+        threads.emplace_back(work, w);
+    }
+    work(0);
+}
+
+// Параллельно разбирает строки буфера, результат совпадает с последовательным scan_lines
+template <auto Fmt, typename... Ts>
+bulk_result<Ts...> scan_chunks(std::string_view buffer, const parallel_options& options) {
+    const auto chunks = split_chunks(buffer, options.chunk_size);
+    const std::size_t workers = std::clamp<std::size_t>(options.threads, 1, std::max<std::size_t>(chunks.size(), 1));
+
+    // При merge_order::input результаты копятся по кускам, иначе - по потокам
+    const std::size_t slots = (options.order == merge_order::input) ? chunks.size() : workers;
+    std::vector<bulk_result<Ts...>> partial(slots);
+
+    run_work_stealing(workers, chunks.size(), [&](std::size_t worker, std::size_t chunk) {
+        auto& target = partial[(options.order == merge_order::input) ? chunk : worker];
+        const auto stats = stdx::scan_lines<Fmt, Ts...>(
+            chunks[chunk], [&](const scan_result<Ts...>& record) { target.records.push_back(record); });
+        target.stats.matched += stats.matched;
+        target.stats.failed += stats.failed;
+    });
+
+    if (partial.size() == 1) {
+        return std::move(partial.front());
+    }
+
+    bulk_result<Ts...> result;
+    std::size_t total = 0;
+    for (const auto& part : partial) {
+        total += part.records.size();
+    }
+    result.records.reserve(total);
+    for (auto& part : partial) {
+        result.records.insert(result.records.end(), part.records.begin(), part.records.end());
+        result.stats.matched += part.stats.matched;
+        result.stats.failed += part.stats.failed;
+    }
+    return result;
+}
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Параллельный разбор строк буфера: буфер делится на куски по границам строк,
+// куски разбираются пулом потоков с кражей работы
+template <details::format_string fmt, typename... Ts>
+details::bulk_result<Ts...> scan_lines_parallel(std::string_view buffer, const details::parallel_options& options = {}) {
+    return details::scan_chunks<fmt, Ts...>(buffer, options);
+}
+
+// Параллельный разбор отображённого в память файла.
+// Результат владеет отображением, поэтому строковые значения остаются действительными вместе с ним
+template <details::format_string fmt, typename... Ts>
+std::expected<details::mapped_bulk_result<Ts...>, std::error_code>
+scan_file_parallel(const std::filesystem::path& path, const details::parallel_options& options = {}) {
+    auto file = details::mapped_file::open(path);
+    if (!file) {
+        return std::unexpected(file.error());
+    }
+    auto result = details::scan_chunks<fmt, Ts...>(file->view(), options);
+    return details::mapped_bulk_result<Ts...>{std::move(result), std::move(*file)};
+}
+
+} // namespace stdx
@@ -1,12 +1,21 @@
 #pragma once
 
-#include <charconv>
+#include <array>
 #include <expected>
 #include <cstdint>
-#include <system_error>
+#include <memory>
+#include <optional>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+#include "floating.hpp"
 #include "format_string.hpp"
+#include "integer.hpp"
+#include "keyword.hpp"
+#include "radix.hpp"
+#include "scanner.hpp"
+#include "search.hpp"
 #include "types.hpp"
 
 namespace stdx::details {
@@ -26,9 +35,15 @@ template<typename T>
 concept SupportedStringType = 
     std::is_same_v<std::remove_cv_t<T>, std::string_view>;
 
+template<typename T>
+concept SupportedFloatType = 
+    std::is_same_v<std::remove_cv_t<T>, float> ||
+    std::is_same_v<std::remove_cv_t<T>, double>;
+
 template<typename T>
 concept SupportedScanType = 
-    SupportedIntegerType<T> || SupportedStringType<T>;
+    SupportedIntegerType<T> || SupportedFloatType<T> || SupportedStringType<T> || SupportedKeywordType<T> ||
+    SupportedByteArrayType<T> || SupportedScannerType<T>;
 
 // Функция для проверки соответствия спецификатора и типа
 template<typename T, char Spec>
@@ -41,138 +56,487 @@ consteval void check_specifier_match() {
     } else if constexpr (Spec == 'u') {
         static_assert(SupportedIntegerType<T> && std::is_unsigned_v<BaseType>,
             "Specifier '%u' requires unsigned integral type");
+    } else if constexpr (Spec == 'x') {
+        static_assert((SupportedIntegerType<T> && std::is_unsigned_v<BaseType>) || SupportedByteArrayType<T>,
+            "Specifier '%x' requires unsigned type or byte array");
+    } else if constexpr (Spec == 'o') {
+        static_assert(SupportedIntegerType<T> && std::is_unsigned_v<BaseType>,
+            "Specifier '%o' requires unsigned integral type");
+    } else if constexpr (Spec == 'b') {
+        static_assert(SupportedIntegerType<T> && std::is_unsigned_v<BaseType>,
+            "Specifier '%b' requires unsigned integral type");
+    } else if constexpr (Spec == 'f') {
+        static_assert(SupportedFloatType<T>,
+            "Specifier '%f' requires float or double type");
     } else if constexpr (Spec == 's') {
         static_assert(SupportedStringType<T>,
             "Specifier '%s' requires std::string_view type");
+    } else if constexpr (Spec == 'k') {
+        static_assert(SupportedKeywordType<T>,
+            "Specifier '%k' requires enum with stdx::keywords");
+    } else if constexpr (is_scanner_specifier(Spec)) {
+        static_assert([] {
+            if constexpr (SupportedScannerType<T>) {
+                return stdx::scanner<BaseType>::specifier == Spec;
+            } else {
+                return false;
+            }
+        }(), "Specifier requires stdx::scanner of the type with the same specifier");
     }
 }
 
 // Функция для получения спецификатора из плейсхолдера
 template<auto Fmt, std::size_t I>
 consteval std::optional<char> get_specifier() {
-    constexpr auto& placeholder = Fmt.placeholder_positions[I];
-    constexpr std::string_view fmt_sv(Fmt.source.data, Fmt.source.size() - 1);
-    constexpr auto placeholder_sv = fmt_sv.substr(placeholder.first, placeholder.second - placeholder.first + 1);
-    
-    constexpr bool has_d_spec = placeholder_sv.find("{%d}") != std::string_view::npos;
-    constexpr bool has_u_spec = placeholder_sv.find("{%u}") != std::string_view::npos;
-    constexpr bool has_s_spec = placeholder_sv.find("{%s}") != std::string_view::npos;
-    
-    if constexpr (has_d_spec) {
-        return 'd';
-    } else if constexpr (has_u_spec) {
-        return 'u';
-    } else if constexpr (has_s_spec) {
-        return 's';
-    } else {
+    constexpr char spec = Fmt.plan.placeholders[I].specifier;
+    if constexpr (spec == '\0') {
         return std::nullopt;
+    } else {
+        return spec;
     }
 }
 
-// Парсинг целых чисел
-template<SupportedIntegerType T>
-consteval std::expected<T, parse_error> parse_value(std::string_view str) {
-    using BaseType = std::remove_cv_t<T>;
-    
-    BaseType value{};
-    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
-    
-    if (ec != std::errc{}) {
-        return std::unexpected(parse_error{"Failed to parse integer"});
+// Отбрасывание пробелов, которыми поле фиксированной ширины дополнено до ширины
+constexpr std::string_view trim_field(std::string_view field) {
+    const std::size_t first = field.find_first_not_of(' ');
+    if (first == std::string_view::npos) {
+        return {};
     }
-    
-    if (ptr != str.data() + str.size()) {
-        return std::unexpected(parse_error{"Extra characters after integer"});
+    return field.substr(first, field.find_last_not_of(' ') + 1 - first);
+}
+
+// Парсинг целых чисел, Width - ширина поля, если она задана в формате, Spec - спецификатор плейсхолдера.
+// {%x}, {%o} и {%b} разбираются в системе счисления по основанию 16, 8 и 2
+template<SupportedIntegerType T, std::size_t Width = 0, char Spec = '\0'>
+constexpr std::expected<T, parse_error> parse_value(std::string_view str) {
+    if constexpr (radix_of(Spec) != 10) {
+        return parse_radix_integer<T, radix_of(Spec)>(Width != 0 ? trim_field(str) : str);
+    } else if constexpr (Width != 0) {
+        return parse_fixed_integer<T, Width>(str);
+    } else {
+        return parse_integer<T>(str);
     }
-    
-    return static_cast<T>(value);
+}
+
+// Парсинг чисел с плавающей точкой, поле фиксированной ширины может быть дополнено пробелами с обеих сторон
+template<SupportedFloatType T, std::size_t Width = 0, char Spec = '\0'>
+constexpr std::expected<T, parse_error> parse_value(std::string_view str) {
+    return parse_float<T>(Width != 0 ? trim_field(str) : str);
 }
 
 // Парсинг строк
-template<SupportedStringType T>
-consteval std::expected<T, parse_error> parse_value(std::string_view str) {
+template<SupportedStringType T, std::size_t Width = 0, char Spec = '\0'>
+constexpr std::expected<T, parse_error> parse_value(std::string_view str) {
     return str;
 }
 
-// Шаблонная функция, возвращающая пару позиций в строке с исходными данными, соотвествующих I-ому плейсхолдеру
-template<int I, stdx::details::format_string Fmt, fixed_string Source>
-consteval auto get_current_source_for_parsing() {
-    static_assert(I >= 0 && I < Fmt.number_placeholders, "Invalid placeholder index");
+// Парсинг ключевых слов в значения перечисления, поле фиксированной ширины дополняется пробелами справа
+template<SupportedKeywordType T, std::size_t Width = 0, char Spec = '\0'>
+constexpr std::expected<T, parse_error> parse_value(std::string_view str) {
+    if constexpr (Width != 0) {
+        str = str.substr(0, str.find_last_not_of(' ') + 1);
+    }
+    return parse_keyword<T>(str);
+}
+
+// Парсинг массива байт из шестнадцатеричных цифр: 2N цифр на массив из N байт
+template<SupportedByteArrayType T, std::size_t Width = 0, char Spec = '\0'>
+constexpr std::expected<std::remove_cv_t<T>, parse_error> parse_value(std::string_view str) {
+    return parse_hex_bytes<T>(Width != 0 ? trim_field(str) : str);
+}
+
+// Парсинг пользовательских типов через stdx::scanner, поле фиксированной ширины передаётся без дополняющих пробелов
+template<SupportedScannerType T, std::size_t Width = 0, char Spec = '\0'>
+constexpr std::expected<std::remove_cv_t<T>, parse_error> parse_value(std::string_view str) {
+    static_assert(is_scanner_specifier(stdx::scanner<std::remove_cv_t<T>>::specifier),
+        "stdx::scanner specifier must be an uppercase letter");
+    return stdx::scanner<std::remove_cv_t<T>>::parse(Width != 0 ? trim_field(str) : str);
+}
 
-    constexpr auto to_sv = [](const auto& fs) {
-        return std::string_view(fs.data, fs.size() - 1);
-    };
+// Проверка соответствия типа T спецификатору I-го плейсхолдера
+template<auto Fmt, std::size_t I, typename T>
+consteval void check_field_type() {
+    constexpr auto spec = get_specifier<Fmt, I>();
+    if constexpr (spec.has_value()) {
+        check_specifier_match<T, spec.value()>();
+    }
+}
 
-    constexpr auto fmt_sv = to_sv(Fmt.source);
-    constexpr auto src_sv = to_sv(Source);
-    constexpr auto& positions = Fmt.placeholder_positions;
+// Функция для получения литерала формата, предшествующего I-ому плейсхолдеру.
+// При I == number_placeholders возвращается хвост формата после последнего плейсхолдера
+template<auto Fmt, std::size_t I>
+consteval std::string_view get_literal() {
+    static_assert(I <= Fmt.number_placeholders, "Invalid literal index");
 
-    // Получаем границы текущего плейсхолдера в формате
-    constexpr auto pos_i = positions[I];
-    constexpr size_t fmt_start = pos_i.first, fmt_end = pos_i.second;
+    constexpr auto literal = Fmt.plan.literals[I];
+    return std::string_view(Fmt.source.data + literal.offset, literal.length);
+}
 
-    // Находим начало в исходной строке
-    constexpr auto src_start = [&]{
-        if constexpr (I == 0) {
-            return fmt_start;
+// Функция для получения литерала формата в виде fixed_string, по которому специализируется поиск разделителя
+template<auto Fmt, std::size_t I>
+consteval auto get_literal_string() {
+    constexpr auto literal = get_literal<Fmt, I>();
+    return fixed_string<literal.size() + 1>(literal.data(), literal.data() + literal.size());
+}
+
+// Шаблонная функция, находящая границы I-го поля в исходной строке без преобразования значения.
+// Поиск начинается с позиции pos, при успехе pos сдвигается за литерал, следующий за плейсхолдером
+template<std::size_t I, auto Fmt>
+constexpr std::expected<std::string_view, parse_error> find_field(std::string_view src, std::size_t& pos) {
+    static_assert(I < Fmt.number_placeholders, "Invalid placeholder index");
+
+    constexpr auto sep = get_literal<Fmt, I + 1>();
+    constexpr std::size_t width = Fmt.plan.placeholders[I].width;
+    std::size_t end = src.size();
+    if constexpr (width != 0) {
+        // Поле фиксированной ширины: следующий литерал проверяется на известной позиции без поиска
+        if (src.size() - pos < width) {
+            return std::unexpected(parse_error{"Field is shorter than its width", error_reason::width});
+        }
+        end = pos + width;
+        if constexpr (I + 1 == Fmt.number_placeholders) {
+            if (src.substr(end) != sep) {
+                return std::unexpected(parse_error{"Trailing literal mismatch", error_reason::literal});
+            }
+        } else if (!src.substr(end).starts_with(sep)) {
+            return std::unexpected(parse_error{"Separator hasn't been found", error_reason::literal});
+        }
+    } else if constexpr (I + 1 == Fmt.number_placeholders) {
+        // Хвост формата должен завершать исходную строку
+        if (!src.substr(pos).ends_with(sep)) {
+            return std::unexpected(parse_error{"Trailing literal mismatch", error_reason::literal});
+        }
+        end -= sep.size();
+    } else {
+        end = literal_searcher<get_literal_string<Fmt, I + 1>()>::find(src, pos);
+        if (end == std::string_view::npos) {
+            return std::unexpected(parse_error{"Separator hasn't been found", error_reason::literal});
+        }
+    }
+
+    const auto field = src.substr(pos, end - pos);
+    pos = end + sep.size();
+    return field;
+}
+
+// Тип значения I-го плейсхолдера среди Ts...
+template<auto Fmt, std::size_t I, typename... Ts>
+using field_type = std::tuple_element_t<Fmt.plan.placeholders[I].argument, std::tuple<Ts...>>;
+
+// Проверка формы поля I-го плейсхолдера без преобразования значения и без проверки диапазона: для %d и %u -
+// что поле является целым числом, для %x, %o и %b - цифрами своей системы счисления, для %f - числом
+// с плавающей точкой, для остальных - ничего. Используется для пропускаемых полей и в match
+template<auto Fmt, std::size_t I>
+constexpr bool check_field_shape(std::string_view field) {
+    constexpr placeholder current = Fmt.plan.placeholders[I];
+    if constexpr (current.specifier == 'f') {
+        return is_float_text(current.width != 0 ? trim_field(field) : field);
+    } else if constexpr (radix_of(current.specifier) != 10) {
+        return is_radix_text<radix_of(current.specifier)>(current.width != 0 ? trim_field(field) : field);
+    } else if constexpr (current.specifier == 'd' || current.specifier == 'u') {
+        return is_integer_text<current.specifier == 'd'>(current.width != 0 ? trim_field(field) : field);
+    } else {
+        return true;
+    }
+}
+
+// Проверка пропускаемого поля I-го плейсхолдера, ошибка - та же, что у сохраняемого поля с этим спецификатором.
+// Поля %s, %k и stdx::scanner без типа не проверяются и ошибки не дают
+template<auto Fmt, std::size_t I>
+constexpr std::optional<parse_error> check_discarded_field(std::string_view field) {
+    if (!check_field_shape<Fmt, I>(field)) {
+        if constexpr (Fmt.plan.placeholders[I].specifier == 'f') {
+            return parse_error{"Failed to parse float", error_reason::syntax};
         } else {
-            // Находим конец предыдущего плейсхолдера в исходной строке
-            constexpr auto prev_bounds = get_current_source_for_parsing<I-1, Fmt, Source>();
-            const auto prev_end = prev_bounds.second;
+            return parse_error{"Failed to parse integer", error_reason::syntax};
+        }
+    }
+    return std::nullopt;
+}
 
-            // Получаем разделитель между текущим и предыдущим плейсхолдерами
-            constexpr auto prev_fmt_end = positions[I-1].second;
-            constexpr auto sep = fmt_sv.substr(prev_fmt_end + 1, fmt_start - (prev_fmt_end + 1));
+// Шаблонная функция, преобразующая поле I-го плейсхолдера и сохраняющая значение в values -
+// кортеж значений или ссылок на поля записи. Пропускаемые поля только проверяются
+template<std::size_t I, auto Fmt, SupportedScanType... Ts>
+constexpr std::optional<parse_error> convert_field(std::string_view field, auto& values) {
+    constexpr placeholder current = Fmt.plan.placeholders[I];
+    if constexpr (current.discard) {
+        return check_discarded_field<Fmt, I>(field);
+    } else {
+        using T = field_type<Fmt, I, Ts...>;
+        // Проверяем соответствие спецификатора и типа
+        check_field_type<Fmt, I, T>();
 
-            // Ищем разделитель после предыдущего значения
-            auto pos = src_sv.find(sep, prev_end);
-            return pos != std::string_view::npos ? pos + sep.size() : src_sv.size();
+        auto value = parse_value<T, current.width, current.specifier>(field);
+        if (!value) {
+            return value.error();
         }
-    }();
+        std::get<current.argument>(values) = *value;
+    }
+    return std::nullopt;
+}
 
-    // Находим конец в исходной строке
-    constexpr auto src_end = [&]{
-        // Получаем разделитель после текущего плейсхолдера
-        if constexpr(fmt_end == (fmt_sv.size() - 1)) {
-            return src_sv.size();
+// Границы сохраняемых полей без преобразования значений: приёмник parse_into для ленивого разбора
+template<std::size_t N>
+struct field_bounds {
+    std::array<std::string_view, N> fields{};
+};
+
+// Запоминает границы поля I-го плейсхолдера вместо преобразования. Соответствие типа спецификатору
+// проверяется для каждого поля, как при обычном разборе, пропускаемые поля проверяются сразу
+template<std::size_t I, auto Fmt, SupportedScanType... Ts, std::size_t N>
+constexpr std::optional<parse_error> convert_field(std::string_view field, field_bounds<N>& bounds) {
+    constexpr placeholder current = Fmt.plan.placeholders[I];
+    if constexpr (current.discard) {
+        return check_discarded_field<Fmt, I>(field);
+    } else {
+        check_field_type<Fmt, I, field_type<Fmt, I, Ts...>>();
+        bounds.fields[current.argument] = field;
+        return std::nullopt;
+    }
+}
+
+// Позиция I-го литерала в записи фиксированной длины
+template<auto Fmt, std::size_t I>
+consteval std::size_t get_fixed_literal_offset() {
+    if constexpr (I == 0) {
+        return 0;
+    } else {
+        return Fmt.plan.offsets[I - 1] + Fmt.plan.placeholders[I - 1].width;
+    }
+}
+
+// Проверка длины записи фиксированной длины и литералов на их позициях
+template<auto Fmt>
+constexpr std::optional<parse_error> check_fixed_record(std::string_view src) {
+    if (src.size() != Fmt.plan.record_size) {
+        return parse_error{"Record length mismatch", error_reason::width};
+    }
+
+    const bool literals_match = [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        return ((src.substr(get_fixed_literal_offset<Fmt, Is>(), get_literal<Fmt, Is>().size()) ==
+                 get_literal<Fmt, Is>()) && ...);
+    }(std::make_index_sequence<Fmt.number_placeholders + 1>{});
+    if (!literals_match) {
+        return parse_error{"Literal mismatch", error_reason::literal};
+    }
+    return std::nullopt;
+}
+
+// Этапы разбора строки, по которым инструментирование считает ошибки и такты.
+// Ошибки поля считаются ещё и по причине error_reason из parse_error
+enum class parse_stage { separator, conversion };
+
+// Точки наблюдения разбора без действий. Точки наблюдения - статические функции типа Probe, а не объекта:
+// лямбды полей ничего не захватывают ради них, и разбор с null_probe не отличается от разбора без точек наблюдения
+struct null_probe {
+    static constexpr void enter(parse_stage) {}
+    static constexpr void leave(parse_stage) {}
+    static constexpr void literal_failed() {}
+    static constexpr void field_failed(std::size_t, parse_stage, error_reason) {}
+};
+
+// Шаблонная функция, разбирающая исходную строку по плану формата за один линейный проход по плейсхолдерам
+// и записывающая значения в values. Запись фиксированной длины разбирается по смещениям,
+// известным в compile-time, без поиска разделителей. Ошибки и этапы разбора сообщаются точкам наблюдения Probe
+template<auto Fmt, SupportedScanType... Ts, typename Probe = null_probe>
+constexpr std::optional<parse_error> parse_into(std::string_view src, auto& values, Probe = {}) {
+    std::optional<parse_error> error;
+    if constexpr (Fmt.plan.fixed) {
+        error = check_fixed_record<Fmt>(src);
+        if (!error) {
+            [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+                ([&] {
+                    Probe::enter(parse_stage::conversion);
+                    error = convert_field<Is, Fmt, Ts...>(
+                        src.substr(Fmt.plan.offsets[Is], Fmt.plan.placeholders[Is].width), values);
+                    Probe::leave(parse_stage::conversion);
+                    if (error) {
+                        Probe::field_failed(Is, parse_stage::conversion, error->reason);
+                    }
+                    return !error;
+                }() && ...);
+            }(std::make_index_sequence<Fmt.number_placeholders>{});
+        } else {
+            Probe::literal_failed();
         }
-        constexpr auto sep = fmt_sv.substr(fmt_end + 1,
-            (I < Fmt.number_placeholders - 1)
-                ? positions[I+1].first - (fmt_end + 1)
-                : fmt_sv.size() - (fmt_end + 1));
-        // Ищем разделитель после текущего значения
-        constexpr auto pos = src_sv.find(sep, src_start);
-        return pos != std::string_view::npos ? pos : src_sv.size();
-    }();
-    return std::pair{src_start, src_end};
-}
-
-// Шаблонная функция, выполняющая преобразования исходных данных в конкретный тип на основе I-го плейсхолдера
-template<int I, auto Fmt, auto Source, SupportedScanType T>
-consteval auto parse_input() {
-    static_assert(I >= 0 && I < Fmt.number_placeholders, "Invalid placeholder index");
+        return error;
+    }
 
-     // Проверяем соответствие спецификатора и типа
-    constexpr auto spec = get_specifier<Fmt, I>();
-    if constexpr (spec.has_value()) {
-        check_specifier_match<T, spec.value()>();
+    constexpr auto prefix = get_literal<Fmt, 0>();
+    if (!src.starts_with(prefix)) {
+        Probe::literal_failed();
+        return parse_error{"Literal prefix mismatch", error_reason::literal};
     }
-    
-    constexpr auto bounds = get_current_source_for_parsing<I, Fmt, Source>();
-    constexpr size_t start = bounds.first;
-    constexpr size_t end = bounds.second;
-    
-    // Проверяем, что границы текущего плейсхолдера корректны
-    static_assert(start <= end, "Invalid parsing bounds");
-    static_assert(end <= Source.size() - 1, "Parsing bounds exceed source size");
+
+    if constexpr (Fmt.number_placeholders == 0) {
+        if (src.size() != prefix.size()) {
+            Probe::literal_failed();
+            return parse_error{"Trailing literal mismatch", error_reason::literal};
+        }
+    } else {
+        std::size_t pos = prefix.size();
+
+        // Разбираем плейсхолдеры по порядку до первой ошибки, пропускаемые поля не сохраняются
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+            ([&] {
+                Probe::enter(parse_stage::separator);
+                const auto field = find_field<Is, Fmt>(src, pos);
+                Probe::leave(parse_stage::separator);
+                if (!field) {
+                    Probe::field_failed(Is, parse_stage::separator, field.error().reason);
+                    error = field.error();
+                } else {
+                    Probe::enter(parse_stage::conversion);
+                    error = convert_field<Is, Fmt, Ts...>(*field, values);
+                    Probe::leave(parse_stage::conversion);
+                    if (error) {
+                        Probe::field_failed(Is, parse_stage::conversion, error->reason);
+                    }
+                }
+                return !error;
+            }() && ...);
+        }(std::make_index_sequence<Fmt.number_placeholders>{});
+    }
+    return error;
+}
+
+// Шаблонная функция, разбирающая исходную строку по плану формата в scan_result
+template<auto Fmt, SupportedScanType... Ts, typename Probe = null_probe>
+constexpr std::expected<scan_result<Ts...>, parse_error> parse_source(std::string_view src, Probe probe = {}) {
+    std::tuple<std::remove_cv_t<Ts>...> values{};
+    if (const auto error = parse_into<Fmt, Ts...>(src, values, probe)) {
+        return std::unexpected(*error);
+    }
+    return std::apply([](const auto&... args) { return scan_result<Ts...>(args...); }, values);
+}
+
+// Шаблонная функция, выполняющая преобразования исходных данных, известных в compile-time, сразу для всех плейсхолдеров
+template<auto Fmt, auto Source, SupportedScanType... Ts>
+consteval auto parse_input() {
+    static_assert(Fmt.number_arguments == sizeof...(Ts), "Invalid number of placeholder types");
 
     constexpr std::string_view src_sv(Source.data, Source.size() - 1);
-    constexpr auto data_sv = src_sv.substr(start, end - start);
-    
-    constexpr auto parsing_result = parse_value<T>(data_sv);
+    constexpr auto parsing_result = parse_source<Fmt, Ts...>(src_sv);
     static_assert(parsing_result.has_value(), "Parsing failed");
-    
+
     return parsing_result.value();
 }
 
-} // namespace stdx::details
\ No newline at end of file
+// Объём исходных данных и число записей, разбираемые одним константным вычислением в scan_all.
+// Блоки вычисляются отдельно, поэтому разбор большой таблицы укладывается в лимиты компилятора
+// на одно вычисление (-fconstexpr-ops-limit, -fconstexpr-steps)
+constexpr std::size_t RECORDS_BLOCK_SIZE = 16384;
+constexpr std::size_t RECORDS_BLOCK_CAPACITY = 1024;
+
+// Очередная непустая строка source начиная с позиции pos, завершающий '\r' отбрасывается.
+// Пустая строка в результате означает, что строки закончились
+constexpr std::string_view next_record(std::string_view source, std::size_t& pos) {
+    while (pos < source.size()) {
+        // Ручной цикл дешевле string_view::find при вычислении в compile-time
+        std::size_t end = pos;
+        while (end < source.size() && source[end] != '\n') {
+            ++end;
+        }
+
+        auto line = source.substr(pos, end - pos);
+        pos = end + 1;
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+        if (!line.empty()) {
+            return line;
+        }
+    }
+    return {};
+}
+
+constexpr std::size_t count_records(std::string_view source) {
+    std::size_t count = 0;
+    for (std::size_t pos = 0; !next_record(source, pos).empty();) {
+        ++count;
+    }
+    return count;
+}
+
+// Границы блока: число непустых строк в нём и позиция начала следующего блока
+struct records_range {
+    std::size_t count = 0;
+    std::size_t end = 0;
+};
+
+constexpr records_range next_records_range(std::string_view source, std::size_t begin) {
+    records_range range{0, begin};
+    while (range.count < RECORDS_BLOCK_CAPACITY && range.end - begin < RECORDS_BLOCK_SIZE &&
+           !next_record(source, range.end).empty()) {
+        ++range.count;
+    }
+    return range;
+}
+
+// Записи одного блока исходных данных
+template <std::size_t Count, typename... Ts>
+struct records_block {
+    std::array<scan_result<Ts...>, Count> records;
+    bool failed = false;
+};
+
+// Разбирает Count непустых строк source начиная с позиции begin
+template<auto Fmt, std::size_t Count, SupportedScanType... Ts>
+consteval records_block<Count, Ts...> parse_records_block(std::string_view source, std::size_t begin) {
+    std::array<scan_result<Ts...>, Count> records{};
+    for (auto& record : records) {
+        auto parsed = parse_source<Fmt, Ts...>(next_record(source, begin));
+        if (!parsed) {
+            return {records, true};
+        }
+        // Значения могут быть const, поэтому запись пересоздаётся, а не присваивается
+        std::destroy_at(&record);
+        std::construct_at(&record, *parsed);
+    }
+    return {records, false};
+}
+
+// Тип-обёртка над исходными данными: шаблоны, параметризованные типом, а не самой строкой,
+// не сравнивают и не хешируют всё её содержимое при каждом обращении
+template <auto Source>
+struct source_holder {
+    static constexpr auto value = Source;
+};
+
+template<auto Fmt, typename Holder, SupportedScanType... Ts>
+struct records_table {
+    static constexpr std::string_view source{Holder::value.data, Holder::value.size() - 1};
+
+    // Разбирает блоки начиная с Begin в records начиная с позиции index.
+    // Каждый блок - отдельное константное вычисление, результат которого не попадает в объектный файл
+    template <std::size_t Begin>
+    static consteval void parse_blocks(auto& records, std::size_t index) {
+        constexpr auto range = next_records_range(source, Begin);
+        constexpr auto block = parse_records_block<Fmt, range.count, Ts...>(source, Begin);
+        static_assert(!block.failed, "Parsing failed");
+
+        for (std::size_t i = 0; i < range.count; ++i) {
+            std::destroy_at(&records[index + i]);
+            std::construct_at(&records[index + i], block.records[i]);
+        }
+        if constexpr (range.end < source.size()) {
+            parse_blocks<range.end>(records, index + range.count);
+        }
+    }
+
+    static consteval auto parse() {
+        std::array<scan_result<Ts...>, count_records(source)> records{};
+        parse_blocks<0>(records, 0);
+        return records;
+    }
+};
+
+// Шаблонная функция, разбирающая в compile-time каждую непустую строку исходных данных за линейное время
+template<auto Fmt, auto Source, SupportedScanType... Ts>
+consteval auto parse_all_input() {
+    static_assert(Fmt.number_arguments == sizeof...(Ts), "Invalid number of placeholder types");
+
+    return records_table<Fmt, source_holder<Source>, Ts...>::parse();
+}
+
+} // namespace stdx::details
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include "integer.hpp"
+#include "types.hpp"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace stdx::details {
+
+// Основание системы счисления для спецификаторов {%x}, {%o} и {%b}, 10 - для остальных
+constexpr unsigned radix_of(char spec) {
+    switch (spec) {
+    case 'x':
+        return 16;
+    case 'o':
+        return 8;
+    case 'b':
+        return 2;
+    default:
+        return 10;
+    }
+}
+
+// Значение цифры в системе счисления до 16 включительно, 0xFF - не цифра
+constexpr std::uint8_t radix_digit(char c) {
+    if (c >= '0' && c <= '9') {
+        return static_cast<std::uint8_t>(c - '0');
+    }
+    const char lower = static_cast<char>(c | 0x20);
+    if (lower >= 'a' && lower <= 'f') {
+        return static_cast<std::uint8_t>(lower - 'a' + 10);
+    }
+    return 0xFF;
+}
+
+// Длина последовательности цифр системы счисления Base
+template <unsigned Base>
+constexpr std::size_t count_radix_digits(const char* p, const char* end) {
+    const char* begin = p;
+    while (p != end && radix_digit(*p) < Base) {
+        ++p;
+    }
+    return static_cast<std::size_t>(p - begin);
+}
+
+#if defined(__SSSE3__)
+namespace sse {
+
+// Значения 16 шестнадцатеричных цифр по одной в байте и признак того, что все 16 байт - цифры
+inline bool decode_nibbles16(const char* p, __m128i& nibbles) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+    const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)),
+                                        _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chunk));
+    const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                         _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+    nibbles = _mm_or_si128(_mm_and_si128(digit, _mm_sub_epi8(chunk, _mm_set1_epi8('0'))),
+                           _mm_and_si128(letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+    return _mm_movemask_epi8(_mm_or_si128(digit, letter)) == 0xFFFF;
+}
+
+// Склейка пар тетрад в 8 байт по порядку записи: в out[0] - первые две цифры
+inline void pack_nibbles16(__m128i nibbles, void* out) {
+    const __m128i bytes = _mm_maddubs_epi16(nibbles, _mm_set1_epi16(0x0110));
+    _mm_storel_epi64(static_cast<__m128i*>(out), _mm_packus_epi16(bytes, bytes));
+}
+
+} // namespace sse
+#endif
+
+// Разбор целого без знака в системе счисления Base с проверками переполнения и лишних символов,
+// как у std::from_chars: без префиксов 0x, 0o и 0b, шестнадцатеричные цифры в любом регистре.
+// В runtime запись из 16 шестнадцатеричных цифр преобразуется за одну загрузку SSE
+template <std::unsigned_integral T, unsigned Base>
+constexpr std::expected<T, parse_error> parse_radix_integer(std::string_view str) {
+    using BaseType = std::remove_cv_t<T>;
+    constexpr auto max_value = static_cast<std::uint64_t>(std::numeric_limits<BaseType>::max());
+
+    const char* p = str.data();
+    const char* const end = p + str.size();
+
+#if defined(__SSSE3__)
+    if constexpr (Base == 16 && std::is_same_v<BaseType, std::uint64_t>) {
+        if !consteval {
+            __m128i nibbles;
+            if (str.size() == 16 && sse::decode_nibbles16(p, nibbles)) {
+                // Первая цифра - старшая, а x86 хранит младший байт первым
+                std::uint64_t value;
+                sse::pack_nibbles16(nibbles, &value);
+                return std::byteswap(value);
+            }
+        }
+    }
+#endif
+
+    std::uint64_t value = 0;
+    bool overflow = false;
+    const std::size_t length = count_radix_digits<Base>(p, end);
+    for (const char* digit = p; digit != p + length; ++digit) {
+        const std::uint8_t current = radix_digit(*digit);
+        if (value > (max_value - current) / Base) {
+            overflow = true;
+            break;
+        }
+        value = value * Base + current;
+    }
+
+    if (length == 0) {
+        return std::unexpected(parse_error{"Failed to parse integer", error_reason::syntax});
+    }
+    if (overflow) {
+        return std::unexpected(parse_error{"Failed to parse integer", error_reason::overflow});
+    }
+    if (length != str.size()) {
+        return std::unexpected(parse_error{"Extra characters after integer", error_reason::extra});
+    }
+    return static_cast<BaseType>(value);
+}
+
+// Проверка, что строка - непустая последовательность цифр системы счисления Base, без преобразования
+template <unsigned Base>
+constexpr bool is_radix_text(std::string_view str) {
+    return !str.empty() && count_radix_digits<Base>(str.data(), str.data() + str.size()) == str.size();
+}
+
+template <typename T>
+struct is_byte_array : std::false_type {};
+
+template <std::size_t N>
+struct is_byte_array<std::array<std::uint8_t, N>> : std::bool_constant<(N > 0)> {};
+
+// Массив байт, записанный шестнадцатеричными цифрами: 128-битные идентификаторы трассировки, хеши
+template <typename T>
+concept SupportedByteArrayType = is_byte_array<std::remove_cv_t<T>>::value;
+
+// Разбор ровно 2N шестнадцатеричных цифр в N байт по порядку записи: первые две цифры - первый байт.
+// В runtime цифры преобразуются блоками по 16 через SSE
+template <SupportedByteArrayType T>
+constexpr std::expected<std::remove_cv_t<T>, parse_error> parse_hex_bytes(std::string_view str) {
+    using BaseType = std::remove_cv_t<T>;
+    constexpr std::size_t size = std::tuple_size_v<BaseType>;
+
+    if (str.size() != 2 * size) {
+        return std::unexpected(parse_error{"Hex field length mismatch", error_reason::width});
+    }
+
+    BaseType bytes{};
+    std::size_t i = 0;
+#if defined(__SSSE3__)
+    if !consteval {
+        for (; i + 8 <= size; i += 8) {
+            __m128i nibbles;
+            if (!sse::decode_nibbles16(str.data() + 2 * i, nibbles)) {
+                return std::unexpected(parse_error{"Failed to parse hex bytes", error_reason::syntax});
+            }
+            sse::pack_nibbles16(nibbles, bytes.data() + i);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        const std::uint8_t high = radix_digit(str[2 * i]);
+        const std::uint8_t low = radix_digit(str[2 * i + 1]);
+        if (high > 0xF || low > 0xF) {
+            return std::unexpected(parse_error{"Failed to parse hex bytes", error_reason::syntax});
+        }
+        bytes[i] = static_cast<std::uint8_t>(high << 4 | low);
+    }
+    return bytes;
+}
+
+} // namespace stdx::details
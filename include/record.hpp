@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include "file.hpp"
+#include "format_string.hpp"
+#include "parse.hpp"
+#include "types.hpp"
+
+namespace stdx::details {
+
+// Наибольшее число полей записи, поддерживаемое разбором в агрегат
+constexpr std::size_t RECORD_MAX_MEMBERS = 16;
+
+// Значение, приводимое к типу любого поля: по нему определяется число полей агрегата
+struct any_member {
+    template <typename T>
+    constexpr operator T() const;
+};
+
+// Число полей агрегата: наибольшее число инициализаторов, с которым Record{...} ещё допустим
+template <typename Record, typename... Probes>
+consteval std::size_t count_members() {
+    if constexpr (sizeof...(Probes) <= RECORD_MAX_MEMBERS && requires { Record{Probes{}..., any_member{}}; }) {
+        return count_members<Record, Probes..., any_member>();
+    } else {
+        return sizeof...(Probes);
+    }
+}
+
+// Кортеж ссылок на поля агрегата через структурное связывание
+template <typename Record>
+constexpr auto tie_members(Record& record) {
+    constexpr std::size_t count = count_members<Record>();
+    static_assert(count <= RECORD_MAX_MEMBERS, "Record has too many members");
+
+    if constexpr (count == 0) {
+        return std::tie();
+    } else if constexpr (count == 1) {
+        auto& [m0] = record;
+        return std::tie(m0);
+    } else if constexpr (count == 2) {
+        auto& [m0, m1] = record;
+        return std::tie(m0, m1);
+    } else if constexpr (count == 3) {
+        auto& [m0, m1, m2] = record;
+        return std::tie(m0, m1, m2);
+    } else if constexpr (count == 4) {
+        auto& [m0, m1, m2, m3] = record;
+        return std::tie(m0, m1, m2, m3);
+    } else if constexpr (count == 5) {
+        auto& [m0, m1, m2, m3, m4] = record;
+        return std::tie(m0, m1, m2, m3, m4);
+    } else if constexpr (count == 6) {
+        auto& [m0, m1, m2, m3, m4, m5] = record;
+        return std::tie(m0, m1, m2, m3, m4, m5);
+    } else if constexpr (count == 7) {
+        auto& [m0, m1, m2, m3, m4, m5, m6] = record;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6);
+    } else if constexpr (count == 8) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7] = record;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7);
+    } else if constexpr (count == 9) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8] = record;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8);
+    } else if constexpr (count == 10) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9] = record;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9);
+    } else if constexpr (count == 11) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = record;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10);
+    } else if constexpr (count == 12) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = record;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11);
+    } else if constexpr (count == 13) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = record;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12);
+    } else if constexpr (count == 14) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13] = record;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13);
+    } else if constexpr (count == 15) {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14] = record;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14);
+    } else {
+        auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15] = record;
+        return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15);
+    }
+}
+
+// Типы полей агрегата в порядке объявления
+template <typename Record>
+using record_members = decltype(tie_members(std::declval<Record&>()));
+
+// Разбирает src по формату Fmt прямо в поля record: i-е сохраняемое значение пишется в i-е поле
+template <auto Fmt, typename Record>
+constexpr std::optional<parse_error> parse_record(std::string_view src, Record& record) {
+    static_assert(std::is_aggregate_v<Record>, "Record must be an aggregate");
+
+    auto members = tie_members(record);
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        using members_type = record_members<Record>;
+        static_assert(Fmt.number_arguments == sizeof...(Is), "Number of placeholders must match number of members");
+        static_assert((!std::is_const_v<std::remove_reference_t<std::tuple_element_t<Is, members_type>>> && ...),
+                      "Record members must not be const");
+        return parse_into<Fmt, std::remove_reference_t<std::tuple_element_t<Is, members_type>>...>(src, members);
+    }(std::make_index_sequence<std::tuple_size_v<record_members<Record>>>{});
+}
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Разбирает input по формату fmt прямо в поля агрегата out без промежуточного кортежа.
+// Поля сопоставляются сохраняемым плейсхолдерам по порядку объявления; при ошибке часть полей может быть изменена
+template <details::format_string fmt, typename Record>
+constexpr std::expected<void, details::parse_error> scan_into(std::string_view input, Record& out) {
+    if (const auto error = details::parse_record<fmt>(input, out)) {
+        return std::unexpected(*error);
+    }
+    return {};
+}
+
+// Разбирает строки буфера по формату fmt в записи out по порядку, неразобранные строки пропускаются.
+// Разбор останавливается, когда out заполнен; matched - число записанных записей
+template <details::format_string fmt, typename Record>
+details::scan_stats scan_into(std::string_view buffer, std::span<Record> out) {
+    details::scan_stats stats;
+    if (out.empty()) {
+        return stats;
+    }
+    details::for_each_line_until(buffer, [&](std::string_view line) {
+        if (details::parse_record<fmt>(line, out[stats.matched])) {
+            ++stats.failed;
+        } else {
+            ++stats.matched;
+        }
+        return stats.matched < out.size();
+    });
+    return stats;
+}
+
+} // namespace stdx
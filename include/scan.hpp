@@ -1,5 +1,7 @@
 #pragma once
 
+#include <expected>
+#include <string_view>
 #include "parse.hpp"
 #include "format_string.hpp"
 #include "types.hpp"
@@ -9,14 +11,31 @@ namespace stdx {
 // Главная функция scan
 template <details::format_string fmt, details::fixed_string source, typename... Ts>
 consteval details::scan_result<Ts...> scan() {
-    static_assert(fmt.number_placeholders == sizeof...(Ts), 
+    static_assert(fmt.number_arguments == sizeof...(Ts), 
         "Number of placeholders must match number of types");
 
-    return []<std::size_t... Is>(std::index_sequence<Is...>) {
-        return details::scan_result<Ts...>(
-            details::parse_input<Is, fmt, source, Ts>()...
-        );
-    }(std::make_index_sequence<sizeof...(Ts)>{});
+    return details::parse_input<fmt, source, Ts...>();
+}
+
+// Разбор в compile-time многострочных данных: каждая непустая строка source разбирается по формату fmt,
+// результат - std::array, размер которого равен числу строк
+template <details::format_string fmt, details::fixed_string source, typename... Ts>
+consteval auto scan_all() {
+    static_assert(fmt.number_arguments == sizeof...(Ts), 
+        "Number of placeholders must match number of types");
+
+    return details::parse_all_input<fmt, source, Ts...>();
+}
+
+// Runtime-версия scan: анализ формата выполняется в compile-time,
+// на каждый вызов остаются только поиск разделителей и преобразование значений
+template <details::format_string fmt, typename... Ts>
+    requires (!details::starts_with_policy<Ts...>)
+constexpr std::expected<details::scan_result<Ts...>, details::parse_error> scan(std::string_view input) {
+    static_assert(fmt.number_arguments == sizeof...(Ts), 
+        "Number of placeholders must match number of types");
+
+    return details::parse_source<fmt, Ts...>(input);
 }
 
 } // namespace stdx
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <concepts>
+#include <expected>
+#include <string_view>
+#include <type_traits>
+#include "types.hpp"
+
+namespace stdx {
+
+// Разбор пользовательского типа T за тот же проход, что и остальные поля. Пользователь специализирует шаблон,
+// задавая спецификатор - заглавную латинскую букву - и функцию разбора, пригодную для constexpr и runtime:
+// template <> struct stdx::scanner<duration> {
+//     static constexpr char specifier = 'D';
+//     static constexpr std::expected<duration, stdx::details::parse_error> parse(std::string_view field);
+// };
+// Поле {%D} или {} разбирается в duration, поле фиксированной ширины передаётся без дополняющих пробелов
+template <typename T>
+struct scanner;
+
+} // namespace stdx
+
+namespace stdx::details {
+
+// Заглавные буквы зарезервированы за спецификаторами stdx::scanner
+constexpr bool is_scanner_specifier(char spec) {
+    return spec >= 'A' && spec <= 'Z';
+}
+
+template <typename T>
+concept SupportedScannerType = requires(std::string_view field) {
+    { stdx::scanner<std::remove_cv_t<T>>::specifier } -> std::convertible_to<char>;
+    { stdx::scanner<std::remove_cv_t<T>>::parse(field) } -> std::same_as<std::expected<std::remove_cv_t<T>, parse_error>>;
+};
+
+} // namespace stdx::details
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "types.hpp"
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace stdx::details {
+
+// Максимальная длина литерала, для которого применяется фильтрация по первому и последнему байтам
+constinit const std::size_t SHORT_LITERAL_MAX_SIZE = 16;
+
+// Векторизованный поиск байта, начиная с позиции pos
+inline std::size_t find_byte(std::string_view haystack, std::size_t pos, char byte) {
+    const char* data = haystack.data();
+    const std::size_t size = haystack.size();
+
+#if defined(__AVX2__)
+    const __m256i pattern32 = _mm256_set1_epi8(byte);
+    for (; pos + 32 <= size; pos += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern32)));
+        if (mask != 0) {
+            return pos + std::countr_zero(mask);
+        }
+    }
+#endif
+#if defined(__SSE2__)
+    const __m128i pattern16 = _mm_set1_epi8(byte);
+    for (; pos + 16 <= size; pos += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern16)));
+        if (mask != 0) {
+            return pos + std::countr_zero(mask);
+        }
+    }
+#endif
+
+    for (; pos < size; ++pos) {
+        if (data[pos] == byte) {
+            return pos;
+        }
+    }
+    return std::string_view::npos;
+}
+
+// Шаблонный класс поиска литерала, известного в compile-time.
+// Алгоритм выбирается по длине литерала: векторизованный поиск байта для одного символа,
+// фильтрация кандидатов по первому и последнему байтам для коротких литералов
+// и таблица сдвигов Хорспула для длинных
+template <fixed_string Literal>
+struct literal_searcher {
+    static constexpr std::string_view literal{Literal.data, Literal.size() - 1};
+
+    static constexpr std::size_t find(std::string_view haystack, std::size_t pos) {
+        if consteval {
+            return haystack.find(literal, pos);
+        } else {
+            if constexpr (literal.empty()) {
+                return pos <= haystack.size() ? pos : std::string_view::npos;
+            } else if constexpr (literal.size() == 1) {
+                return find_byte(haystack, pos, literal[0]);
+            } else if constexpr (literal.size() <= SHORT_LITERAL_MAX_SIZE) {
+                return find_short(haystack, pos);
+            } else {
+                return find_long(haystack, pos);
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t K = literal.size();
+
+    // Сравнение внутренних байтов кандидата, первый и последний уже совпали
+    static bool matches_inner(const char* candidate) {
+        if constexpr (K > 2) {
+            return std::memcmp(candidate + 1, literal.data() + 1, K - 2) == 0;
+        } else {
+            return true;
+        }
+    }
+
+    static std::size_t find_short(std::string_view haystack, std::size_t pos) {
+        const char* data = haystack.data();
+        const std::size_t size = haystack.size();
+        if (pos > size || size - pos < K) {
+            return std::string_view::npos;
+        }
+        // Позиции начала кандидатов лежат в диапазоне [pos, end)
+        const std::size_t end = size - K + 1;
+
+#if defined(__AVX2__)
+        const __m256i first32 = _mm256_set1_epi8(literal.front());
+        const __m256i last32 = _mm256_set1_epi8(literal.back());
+        for (; pos + 32 <= end; pos += 32) {
+            const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+            const __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos + K - 1));
+            const __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(head, first32), _mm256_cmpeq_epi8(tail, last32));
+            for (auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(eq)); mask != 0; mask &= mask - 1) {
+                const std::size_t candidate = pos + std::countr_zero(mask);
+                if (matches_inner(data + candidate)) {
+                    return candidate;
+                }
+            }
+        }
+#endif
+#if defined(__SSE2__)
+        const __m128i first16 = _mm_set1_epi8(literal.front());
+        const __m128i last16 = _mm_set1_epi8(literal.back());
+        for (; pos + 16 <= end; pos += 16) {
+            const __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+            const __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + K - 1));
+            const __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(head, first16), _mm_cmpeq_epi8(tail, last16));
+            for (auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(eq)); mask != 0; mask &= mask - 1) {
+                const std::size_t candidate = pos + std::countr_zero(mask);
+                if (matches_inner(data + candidate)) {
+                    return candidate;
+                }
+            }
+        }
+#endif
+
+        for (; pos < end; ++pos) {
+            if (data[pos] == literal.front() && data[pos + K - 1] == literal.back() && matches_inner(data + pos)) {
+                return pos;
+            }
+        }
+        return std::string_view::npos;
+    }
+
+    // Таблица сдвигов Хорспула по последнему байту окна
+    static constexpr auto skip_table = [] {
+        std::array<std::size_t, 256> table{};
+        table.fill(K);
+        for (std::size_t i = 0; i + 1 < K; ++i) {
+            table[static_cast<unsigned char>(literal[i])] = K - 1 - i;
+        }
+        return table;
+    }();
+
+    static std::size_t find_long(std::string_view haystack, std::size_t pos) {
+        const char* data = haystack.data();
+        const std::size_t size = haystack.size();
+        if (pos > size || size - pos < K) {
+            return std::string_view::npos;
+        }
+
+        const std::size_t end = size - K + 1;
+        while (pos < end) {
+            const char last = data[pos + K - 1];
+            if (last == literal.back() && std::memcmp(data + pos, literal.data(), K - 1) == 0) {
+                return pos;
+            }
+            pos += skip_table[static_cast<unsigned char>(last)];
+        }
+        return std::string_view::npos;
+    }
+};
+
+} // namespace stdx::details
@@ -0,0 +1,374 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <expected>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <version>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include "file.hpp"
+#include "format_string.hpp"
+#include "scan.hpp"
+#include "search.hpp"
+#include "types.hpp"
+
+#if defined(__cpp_lib_generator)
+#include <generator>
+#endif
+
+namespace stdx::details {
+
+// Деление последовательности буферов на строки: строки внутри буфера выдаются без копирования,
+// строка, перешедшая через границу буферов, собирается в промежуточном буфере. Завершающий '\r' отбрасывается.
+// Общее для stream_scanner и scan_stream
+class line_splitter {
+public:
+    void feed(std::string_view chunk) {
+        data_ = chunk;
+        pos_ = 0;
+    }
+
+    // Следующая завершённая строка текущего буфера, false - буфер исчерпан, незавершённый хвост сохранён
+    bool next(std::string_view& line) {
+        release_joined();
+        const std::size_t newline = literal_searcher<fixed_string{"\n"}>::find(data_, pos_);
+        if (newline == std::string_view::npos) {
+            carry_.append(data_.substr(pos_));
+            data_ = {};
+            pos_ = 0;
+            return false;
+        }
+        if (carry_.empty()) {
+            line = data_.substr(pos_, newline - pos_);
+        } else {
+            carry_.append(data_.substr(pos_, newline - pos_));
+            line = carry_;
+            joined_ = true;
+        }
+        pos_ = newline + 1;
+        strip_cr(line);
+        return true;
+    }
+
+    // Последняя строка, не завершённая переводом строки
+    bool finish(std::string_view& line) {
+        release_joined();
+        if (carry_.empty()) {
+            return false;
+        }
+        line = carry_;
+        joined_ = true;
+        strip_cr(line);
+        return true;
+    }
+
+    // Объём промежуточного буфера, не превышает длины самой длинной строки
+    std::size_t carry_capacity() const { return carry_.capacity(); }
+
+private:
+    void release_joined() {
+        if (joined_) {
+            carry_.clear();
+            joined_ = false;
+        }
+    }
+
+    static void strip_cr(std::string_view& line) {
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+    }
+
+    std::string_view data_;
+    std::size_t pos_ = 0;
+    std::string carry_;
+    bool joined_ = false;
+};
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Потоковый разбор записей, разделённых '\n', из буферов произвольного размера (каналы, сокеты).
+// Записи, целиком лежащие в одном буфере, разбираются без копирования, в промежуточный буфер
+// копируется только незавершённый хвост, поэтому расход памяти ограничен длиной самой длинной записи.
+// Результаты, переданные в on_record, действительны только во время вызова
+template <details::format_string fmt, typename... Ts>
+class stream_scanner {
+public:
+    // Разбирает все записи, завершённые в chunk, и сохраняет незавершённый хвост
+    template <typename F>
+    void feed(std::span<const char> chunk, F&& on_record) {
+        lines_.feed({chunk.data(), chunk.size()});
+        std::string_view line;
+        while (lines_.next(line)) {
+            scan_line(line, on_record);
+        }
+    }
+
+    // Разбирает последнюю запись, не завершённую переводом строки
+    template <typename F>
+    void finish(F&& on_record) {
+        if (std::string_view line; lines_.finish(line)) {
+            scan_line(line, on_record);
+        }
+    }
+
+    const details::scan_stats& stats() const { return stats_; }
+
+    // Объём промежуточного буфера, не превышает длины самой длинной записи
+    std::size_t carry_capacity() const { return lines_.carry_capacity(); }
+
+private:
+    template <typename F>
+    void scan_line(std::string_view line, F& on_record) {
+        auto result = scan<fmt, Ts...>(line);
+        if (result) {
+            ++stats_.matched;
+            on_record(*result);
+        } else {
+            ++stats_.failed;
+        }
+    }
+
+    details::line_splitter lines_;
+    details::scan_stats stats_;
+};
+
+} // namespace stdx
+
+namespace stdx::details {
+
+// Параметры чтения с опережением: размер буфера и число буферов, которые читатель заполняет впрок
+struct read_ahead_options {
+    std::size_t buffer_size = std::size_t{1} << 20;
+    std::size_t depth = 3;
+};
+
+// Чтение файлового дескриптора с опережением: фоновый поток заполняет буферы через pread (read для каналов
+// и сокетов), пока потребитель разбирает уже прочитанный. Буфер, выданный next(), действителен до следующего вызова.
+// Чтение канала или сокета ждёт данных в poll вместе с внутренним каналом пробуждения, поэтому разрушение
+// read_ahead после досрочного выхода потребителя не ждёт, пока пишущая сторона пришлёт данные или закроется
+class read_ahead {
+public:
+    read_ahead(int fd, read_ahead_options options)
+        : fd_(fd), buffer_size_(std::max<std::size_t>(options.buffer_size, 1)) {
+        if (::pipe(wake_) != 0) {
+            error_ = std::error_code(errno, std::generic_category());
+            wake_[0] = wake_[1] = -1;
+            done_ = true;
+            return;
+        }
+        ::fcntl(wake_[0], F_SETFD, FD_CLOEXEC);
+        ::fcntl(wake_[1], F_SETFD, FD_CLOEXEC);
+
+        const std::size_t depth = std::max<std::size_t>(options.depth, 2);
+        for (std::size_t i = 0; i < depth; ++i) {
+            buffers_.push_back(std::make_unique_for_overwrite<char[]>(buffer_size_));
+            free_.push_back(buffers_.back().get());
+        }
+        thread_ = std::jthread([this](std::stop_token stop) { run(stop); });
+    }
+
+    read_ahead(const read_ahead&) = delete;
+    read_ahead& operator=(const read_ahead&) = delete;
+
+    ~read_ahead() {
+        if (thread_.joinable()) {
+            thread_.request_stop();
+            const char signal = 0;
+            while (::write(wake_[1], &signal, 1) < 0 && errno == EINTR) {
+            }
+            thread_.join();
+        }
+        if (wake_[0] >= 0) {
+            ::close(wake_[0]);
+            ::close(wake_[1]);
+        }
+    }
+
+    // Следующий прочитанный буфер, пустой - конец данных или ошибка чтения. Предыдущий буфер возвращается читателю
+    std::span<const char> next() {
+        std::unique_lock lock(mutex_);
+        if (current_ != nullptr) {
+            free_.push_back(current_);
+            current_ = nullptr;
+            changed_.notify_all();
+        }
+        changed_.wait(lock, [&] { return !ready_.empty() || done_; });
+        if (ready_.empty()) {
+            return {};
+        }
+        const std::span<const char> chunk = ready_.front();
+        ready_.pop_front();
+        current_ = const_cast<char*>(chunk.data());
+        return chunk;
+    }
+
+    // Ошибка чтения, после которой next() вернул пустой буфер
+    std::error_code error() const {
+        const std::lock_guard lock(mutex_);
+        return error_;
+    }
+
+private:
+    void run(std::stop_token stop) {
+        // Для файлов читаем по смещению от текущей позиции, для каналов и сокетов lseek завершается ошибкой
+        off_t offset = ::lseek(fd_, 0, SEEK_CUR);
+        const bool positional = offset >= 0;
+        std::error_code error;
+        for (;;) {
+            char* buffer = nullptr;
+            {
+                std::unique_lock lock(mutex_);
+                if (!changed_.wait(lock, stop, [&] { return !free_.empty(); })) {
+                    break;
+                }
+                buffer = free_.back();
+                free_.pop_back();
+            }
+
+            ssize_t size = 0;
+            if (!positional && !wait_readable(error)) {
+                const std::lock_guard lock(mutex_);
+                free_.push_back(buffer);
+                break;
+            }
+            do {
+                size = positional ? ::pread(fd_, buffer, buffer_size_, offset) : ::read(fd_, buffer, buffer_size_);
+            } while (size < 0 && errno == EINTR);
+            if (size < 0) {
+                error = std::error_code(errno, std::generic_category());
+            }
+
+            const std::lock_guard lock(mutex_);
+            if (size <= 0) {
+                free_.push_back(buffer);
+                break;
+            }
+            offset += size;
+            ready_.emplace_back(buffer, static_cast<std::size_t>(size));
+            changed_.notify_all();
+        }
+
+        const std::lock_guard lock(mutex_);
+        error_ = error;
+        done_ = true;
+        changed_.notify_all();
+    }
+
+    // Ожидание данных канала или сокета, false - разрушение read_ahead или ошибка poll.
+    // Отрицательный дескриптор poll пропустил бы, его ошибку сообщает read
+    bool wait_readable(std::error_code& error) {
+        if (fd_ < 0) {
+            return true;
+        }
+        pollfd fds[2] = {{fd_, POLLIN, 0}, {wake_[0], POLLIN, 0}};
+        int ready = 0;
+        do {
+            ready = ::poll(fds, 2, -1);
+        } while (ready < 0 && errno == EINTR);
+        if (ready < 0) {
+            error = std::error_code(errno, std::generic_category());
+            return false;
+        }
+        return fds[1].revents == 0;
+    }
+
+    int fd_;
+    std::size_t buffer_size_;
+    int wake_[2] = {-1, -1};
+    std::vector<std::unique_ptr<char[]>> buffers_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable_any changed_;
+    std::vector<char*> free_;
+    std::deque<std::span<const char>> ready_;
+    char* current_ = nullptr;
+    bool done_ = false;
+    std::error_code error_;
+
+    // Поток объявлен последним: он останавливается и присоединяется до разрушения очередей
+    std::jthread thread_;
+};
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Разбор записей из файлового дескриптора с чтением впрок: пока on_record получает записи текущего буфера,
+// фоновый поток читает следующие. Результаты, переданные в on_record, действительны только во время вызова
+template <details::format_string fmt, typename... Ts, typename F>
+    requires std::invocable<F&, const details::scan_result<Ts...>&>
+std::expected<details::scan_stats, std::error_code> scan_stream(int fd, F&& on_record,
+                                                                details::read_ahead_options options = {}) {
+    details::read_ahead reader(fd, options);
+    details::line_splitter lines;
+    details::scan_stats stats;
+    const auto scan_line = [&](std::string_view line) {
+        if (const auto result = scan<fmt, Ts...>(line)) {
+            ++stats.matched;
+            on_record(*result);
+        } else {
+            ++stats.failed;
+        }
+    };
+
+    std::string_view line;
+    for (auto chunk = reader.next(); !chunk.empty(); chunk = reader.next()) {
+        lines.feed({chunk.data(), chunk.size()});
+        while (lines.next(line)) {
+            scan_line(line);
+        }
+    }
+    if (lines.finish(line)) {
+        scan_line(line);
+    }
+    if (const auto error = reader.error()) {
+        return std::unexpected(error);
+    }
+    return stats;
+}
+
+#if defined(__cpp_lib_generator)
+// Поток записей из файлового дескриптора для циклов вида for (const auto& r : scan_stream<fmt, Ts...>(fd)):
+// разбор текущего буфера идёт одновременно с чтением следующих. Строки, не соответствующие формату, пропускаются,
+// ошибка чтения завершает поток. Запись действительна до перехода к следующей
+template <details::format_string fmt, typename... Ts>
+std::generator<const details::scan_result<Ts...>&> scan_stream(int fd, details::read_ahead_options options = {}) {
+    details::read_ahead reader(fd, options);
+    details::line_splitter lines;
+
+    std::string_view line;
+    for (auto chunk = reader.next(); !chunk.empty(); chunk = reader.next()) {
+        lines.feed({chunk.data(), chunk.size()});
+        while (lines.next(line)) {
+            if (const auto result = scan<fmt, Ts...>(line)) {
+                co_yield *result;
+            }
+        }
+    }
+    if (lines.finish(line)) {
+        if (const auto result = scan<fmt, Ts...>(line)) {
+            co_yield *result;
+        }
+    }
+}
+#endif
+
+} // namespace stdx
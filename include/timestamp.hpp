@@ -0,0 +1,131 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <string_view>
+#include "scanner.hpp"
+#include "types.hpp"
+
+namespace stdx::details {
+
+// Число из Count десятичных цифр, начиная с позиции pos, -1 - если среди них есть не цифра
+template <std::size_t Count>
+constexpr int read_fixed_digits(std::string_view str, std::size_t pos) {
+    int value = 0;
+    for (std::size_t i = 0; i < Count; ++i) {
+        const unsigned digit = static_cast<unsigned char>(str[pos + i]) - static_cast<unsigned>('0');
+        if (digit > 9) {
+            return -1;
+        }
+        value = value * 10 + static_cast<int>(digit);
+    }
+    return value;
+}
+
+// Смещение часового пояса ISO-8601: Z, ±HH, ±HHMM или ±HH:MM, начиная с позиции pos до конца строки
+constexpr std::expected<std::chrono::minutes, parse_error> parse_utc_offset(std::string_view str, std::size_t pos) {
+    const auto error = [] { return std::unexpected(parse_error{"Failed to parse timestamp", error_reason::syntax}); };
+    const std::size_t length = str.size() - pos;
+    if (length == 0 || (length == 1 && (str[pos] == 'Z' || str[pos] == 'z'))) {
+        return std::chrono::minutes{0};
+    }
+    if ((str[pos] != '+' && str[pos] != '-') || (length != 3 && length != 5 && length != 6)) {
+        return error();
+    }
+    const int hours = read_fixed_digits<2>(str, pos + 1);
+    int minutes = 0;
+    if (length == 5) {
+        minutes = read_fixed_digits<2>(str, pos + 3);
+    } else if (length == 6) {
+        minutes = str[pos + 3] == ':' ? read_fixed_digits<2>(str, pos + 4) : -1;
+    }
+    if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59) {
+        return error();
+    }
+    const std::chrono::minutes offset{hours * 60 + minutes};
+    return str[pos] == '-' ? -offset : offset;
+}
+
+// Разбор метки времени ISO-8601 за один проход: YYYY-MM-DD, затем необязательно 'T' или пробел, HH:MM:SS,
+// дробная часть секунды после '.' или ',' и смещение часового пояса. Без смещения время считается UTC.
+// Дробная часть точнее наносекунд и точнее Duration отбрасывается
+template <typename Duration>
+constexpr std::expected<std::chrono::sys_time<Duration>, parse_error> parse_timestamp(std::string_view str) {
+    using namespace std::chrono;
+    const auto error = [] { return std::unexpected(parse_error{"Failed to parse timestamp", error_reason::syntax}); };
+
+    if (str.size() < 10 || str[4] != '-' || str[7] != '-') {
+        return error();
+    }
+    const int y = read_fixed_digits<4>(str, 0);
+    const int m = read_fixed_digits<2>(str, 5);
+    const int d = read_fixed_digits<2>(str, 8);
+    if (y < 0 || m < 0 || d < 0) {
+        return error();
+    }
+    const year_month_day date{year{y}, month{static_cast<unsigned>(m)}, day{static_cast<unsigned>(d)}};
+    if (!date.ok()) {
+        return error();
+    }
+    sys_seconds seconds_point{sys_days{date}};
+    nanoseconds fraction{0};
+    std::size_t pos = 10;
+
+    if (pos < str.size() && (str[pos] == 'T' || str[pos] == 't' || str[pos] == ' ')) {
+        if (str.size() < pos + 9 || str[pos + 3] != ':' || str[pos + 6] != ':') {
+            return error();
+        }
+        const int hh = read_fixed_digits<2>(str, pos + 1);
+        const int mm = read_fixed_digits<2>(str, pos + 4);
+        const int ss = read_fixed_digits<2>(str, pos + 7);
+        if (hh < 0 || hh > 23 || mm < 0 || mm > 59 || ss < 0 || ss > 59) {
+            return error();
+        }
+        seconds_point += hours{hh} + minutes{mm} + seconds{ss};
+        pos += 9;
+
+        if (pos < str.size() && (str[pos] == '.' || str[pos] == ',')) {
+            ++pos;
+            const std::size_t begin = pos;
+            std::int64_t value = 0;
+            std::size_t digits = 0;
+            for (; pos < str.size() && str[pos] >= '0' && str[pos] <= '9'; ++pos) {
+                if (digits < 9) {
+                    value = value * 10 + (str[pos] - '0');
+                    ++digits;
+                }
+            }
+            if (pos == begin) {
+                return error();
+            }
+            for (; digits < 9; ++digits) {
+                value *= 10;
+            }
+            fraction = nanoseconds{value};
+        }
+    }
+
+    const auto offset = parse_utc_offset(str, pos);
+    if (!offset) {
+        return std::unexpected(offset.error());
+    }
+    return floor<Duration>(seconds_point - *offset) + floor<Duration>(fraction);
+}
+
+} // namespace stdx::details
+
+namespace stdx {
+
+// Метки времени ISO-8601 в std::chrono::sys_time любой точности: {%T}
+template <typename Duration>
+struct scanner<std::chrono::sys_time<Duration>> {
+    static constexpr char specifier = 'T';
+
+    static constexpr std::expected<std::chrono::sys_time<Duration>, details::parse_error> parse(std::string_view field) {
+        return details::parse_timestamp<Duration>(field);
+    }
+};
+
+} // namespace stdx
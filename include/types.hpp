@@ -2,27 +2,30 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <tuple>
+#include <type_traits>
 
 namespace stdx::details {
 
 constinit const std::size_t PARSE_ERROR_MAX_SIZE = 43;
 
-// Шаблонный класс, хранящий C-style строку фиксированной длины
+// Шаблонный класс, хранящий C-style строку фиксированной длины.
+// Конструкторы constexpr, а не consteval: parse_error создаётся и при разборе в runtime
 template <std::size_t N>
 struct fixed_string {
     char data[N] = {};
 
-    consteval fixed_string(const char (&str)[N]) {
+    constexpr fixed_string(const char (&str)[N]) {
         std::copy_n(str, N, data);
     }
 
     template <std::size_t M>
-    consteval fixed_string(const char (&str)[M]) requires (M <= N) {
+    constexpr fixed_string(const char (&str)[M]) requires (M <= N) {
         std::copy_n(str, M - 1, data);
     }
 
-    consteval fixed_string(const char* begin, const char* end) {
+    constexpr fixed_string(const char* begin, const char* end) {
         const std::size_t len = end - begin;
         std::copy_n(begin, (len < N ? len : N), data);
     }
@@ -30,10 +33,26 @@ struct fixed_string {
     consteval std::size_t size() const { return N; }
 };
 
+// Причина ошибки парсинга поля - для счётчиков инструментирования, текст ошибки от неё не зависит
+enum class error_reason : std::uint8_t {
+    other,    // прочие ошибки
+    literal,  // литерал или разделитель не совпал
+    width,    // поле или запись фиксированной ширины короче нужного
+    syntax,   // текст поля не разбирается спецификатором
+    overflow, // значение не помещается в тип
+    extra,    // после значения остались лишние символы
+    keyword,  // слово не входит в набор %k
+};
+
+constinit const std::size_t ERROR_REASON_COUNT = 7;
+
 // Шаблонный класс для хранения ошибки парсинга
 struct parse_error : fixed_string<PARSE_ERROR_MAX_SIZE> {
+    error_reason reason = error_reason::other;
+
     template <std::size_t M>
-    constexpr parse_error(const char (&str)[M]) : fixed_string<PARSE_ERROR_MAX_SIZE>(str) {}
+    constexpr parse_error(const char (&str)[M], error_reason reason = error_reason::other)
+        : fixed_string<PARSE_ERROR_MAX_SIZE>(str), reason(reason) {}
 };
 
 // Шаблонный класс для хранения результатов парсинга
@@ -41,11 +60,44 @@ template <typename... Ts>
 struct scan_result {
     std::tuple<Ts...> data;
 
-    consteval scan_result(Ts... args) : data(args...) {}
+    constexpr scan_result() requires (sizeof...(Ts) > 0) = default;
+
+    constexpr scan_result(Ts... args) : data(args...) {}
 
-    consteval const std::tuple<Ts...>& values() const {
+    constexpr const std::tuple<Ts...>& values() const {
         return data;
     }
 };
 
 } // namespace stdx::details
+
+namespace stdx {
+
+// Политика инструментирования runtime-версии scan: scan<fmt, stdx::instrumented<>, Ts...>(input) ведёт счётчики
+// формата fmt, при SampleEvery != 0 каждая SampleEvery-я строка потока дополнительно замеряется в тактах
+template <std::size_t SampleEvery = 0>
+struct instrumented {
+    static constexpr std::size_t sample_every = SampleEvery;
+};
+
+} // namespace stdx
+
+namespace stdx::details {
+
+template <typename T>
+struct is_instrumentation_policy : std::false_type {};
+
+template <std::size_t SampleEvery>
+struct is_instrumentation_policy<stdx::instrumented<SampleEvery>> : std::true_type {};
+
+template <typename T>
+concept InstrumentationPolicy = is_instrumentation_policy<T>::value;
+
+// Первый из типов плейсхолдеров - политика инструментирования, а не тип значения
+template <typename... Ts>
+constexpr bool starts_with_policy = false;
+
+template <typename T, typename... Ts>
+constexpr bool starts_with_policy<T, Ts...> = InstrumentationPolicy<T>;
+
+} // namespace stdx::details
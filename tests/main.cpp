@@ -1,8 +1,40 @@
 #include "types.hpp"
 #include "format_string.hpp"
 #include "scan.hpp"
+#include "search.hpp"
+#include "file.hpp"
+#include "parallel.hpp"
+#include "columns.hpp"
+#include "stream.hpp"
+#include "dispatch.hpp"
+#include "lazy.hpp"
+#include "record.hpp"
+#include "match.hpp"
+#include "instrument.hpp"
+#include "arena.hpp"
+#include "timestamp.hpp"
+#include "address.hpp"
+#include <array>
+#include <bit>
 #include <cassert>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+
+// Конфигурация CI требует, чтобы тесты генератора scan_stream собирались и выполнялись
+#if defined(SCAN_REQUIRE_GENERATOR) && !defined(__cpp_lib_generator)
+#error "SCAN_REQUIRE_GENERATOR is set, but the standard library does not provide std::generator"
+#endif
 
 using stdx::details::fixed_string;
 using namespace stdx::details::literals;
@@ -68,9 +100,18 @@ static_assert("{%d}"_fs.number_placeholders == 1);
 static_assert("{%s}"_fs.number_placeholders == 1);
 static_assert("{%u}"_fs.number_placeholders == 1);
 
-// === 6. Проверка, что при неправильной строке будет ошибка компиляции ===
+// === 6. Проверка плана разбора ===
+static_assert("{%d} and {}"_fs.plan.placeholders[0].specifier == 'd');
+static_assert("{%d} and {}"_fs.plan.placeholders[1].specifier == '\0');
+static_assert("{%d} and {}"_fs.plan.literals[0].length == 0);
+static_assert("{%d} and {}"_fs.plan.literals[1].offset == 4);
+static_assert("{%d} and {}"_fs.plan.literals[1].length == 5);
+static_assert("{%d} and {}"_fs.plan.literals[2].length == 0);
+static_assert("No placeholders"_fs.plan.literals[0].length == 15);
+
+// === 7. Проверка, что при неправильной строке будет ошибка компиляции ===
 // static_assert("Unclosed {"_fs.number_placeholders); // Ошибка компиляции
-// static_assert("{%x}"_fs.number_placeholders); // Ошибка компиляции
+// static_assert("{%q}"_fs.number_placeholders); // Ошибка компиляции
 
 // ========== Тестирование функции scan ==========
 // === 1. Базовые тесты с одним плейсхолдером ===
@@ -154,6 +195,13 @@ static_assert(std::is_same_v<decltype(test_multi3), const stdx::details::scan_re
 static_assert(std::is_same_v<decltype(test_multi4), const stdx::details::scan_result<std::string_view, int, std::string_view>>);
 static_assert(std::is_same_v<decltype(test_multi5), const stdx::details::scan_result<std::string_view, int, unsigned int>>);
 
+// === 9. Много плейсхолдеров разбираются за один проход по плану ===
+constexpr auto test_multi9 = stdx::scan<"{},{},{},{},{},{},{},{},{},{},{},{},{},{},{},{}"_fs,
+    "0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15", int, int, int, int, int, int, int, int, int, int, int, int, int, int, int, int>();
+static_assert(std::get<0>(test_multi9.values()) == 0);
+static_assert(std::get<9>(test_multi9.values()) == 9);
+static_assert(std::get<15>(test_multi9.values()) == 15);
+
 // ========== Тесты поддерживаемых типов ==========
 // Целочисленные типы со знаком
 constexpr auto test_int8 = stdx::scan<"{}"_fs, "127", int8_t>();
@@ -195,6 +243,430 @@ constexpr auto test_spec_match3 = stdx::scan<"{%u}"_fs, "123", unsigned int>();
 constexpr auto test_spec_match4 = stdx::scan<"{%u}"_fs, "255", uint8_t>();
 constexpr auto test_spec_match5 = stdx::scan<"{%s}"_fs, "hello", std::string_view>();
 
+// ========== Тестирование runtime-версии scan ==========
+// === 1. Разбор строки с одним и несколькими плейсхолдерами ===
+static_assert(std::get<0>(stdx::scan<"Value: {}"_fs, int>("Value: 42")->values()) == 42);
+static_assert(std::get<1>(stdx::scan<"{} {}"_fs, std::string_view, int>("hello 42")->values()) == 42);
+static_assert(std::get<2>(stdx::scan<"{%d} {%u} {%s}"_fs, int, unsigned, std::string_view>("-1 2 three")->values()) ==
+              "three");
+static_assert(std::get<0>(stdx::scan<"[{}]"_fs, std::string_view>("[tail]")->values()) == "tail");
+
+// === 2. Формат без плейсхолдеров ===
+static_assert(stdx::scan<"literal"_fs>("literal").has_value());
+static_assert(!stdx::scan<"literal"_fs>("literal!").has_value());
+
+// === 3. Ошибки разбора возвращаются через std::expected ===
+static_assert(!stdx::scan<"Value: {}"_fs, int>("Price: 42").has_value());
+static_assert(!stdx::scan<"{} {}"_fs, int, int>("1,2").has_value());
+static_assert(!stdx::scan<"[{}]"_fs, std::string_view>("[tail").has_value());
+static_assert(!stdx::scan<"{%u}"_fs, unsigned>("-1").has_value());
+static_assert(!stdx::scan<"{}"_fs, uint8_t>("256").has_value());
+
+// ========== Тестирование разбора целых чисел ==========
+using stdx::details::parse_integer;
+static_assert(parse_integer<uint64_t>("18446744073709551615").value() == 18446744073709551615ULL);
+static_assert(!parse_integer<uint64_t>("18446744073709551616").has_value());
+static_assert(parse_integer<int64_t>("-9223372036854775808").value() == INT64_MIN);
+static_assert(!parse_integer<int64_t>("9223372036854775808").has_value());
+static_assert(parse_integer<int8_t>("-128").value() == -128);
+static_assert(!parse_integer<int8_t>("128").has_value());
+static_assert(parse_integer<uint16_t>("000000000000000000000065535").value() == 65535);
+static_assert(!parse_integer<int32_t>("-").has_value());
+static_assert(!parse_integer<uint32_t>("-0").has_value());
+static_assert(std::string_view(parse_integer<uint32_t>("12a").error().data) == "Extra characters after integer");
+static_assert(std::string_view(parse_integer<uint8_t>("999a").error().data) == "Failed to parse integer");
+static_assert(parse_integer<uint8_t>("999a").error().reason == stdx::details::error_reason::overflow);
+static_assert(parse_integer<int32_t>("-").error().reason == stdx::details::error_reason::syntax);
+static_assert(parse_integer<uint32_t>("12a").error().reason == stdx::details::error_reason::extra);
+
+// ========== Тестирование поиска литералов ==========
+using stdx::details::literal_searcher;
+static_assert(literal_searcher<fixed_string{", "}>::find("a, b, c", 2) == 4);
+static_assert(literal_searcher<fixed_string{"|"}>::find("abc", 0) == std::string_view::npos);
+static_assert(literal_searcher<fixed_string{""}>::find("abc", 1) == 1);
+
+// ========== Тестирование разбора несколькими форматами ==========
+using stdx::details::pattern;
+using login_pattern = pattern<"LOGIN user={%s}"_fs, std::string_view>;
+using logout_pattern = pattern<"LOGOUT user={%s} after={%u}s"_fs, std::string_view, uint32_t>;
+using error_pattern = pattern<"ERR {%d}"_fs, int>;
+using fallback_pattern = pattern<"{}"_fs, std::string_view>;
+
+constexpr auto any1 = stdx::scan_any<login_pattern, logout_pattern, error_pattern>("LOGOUT user=bob after=30s");
+static_assert(any1.has_value() && any1->index() == 1);
+static_assert(std::get<1>(std::get<1>(*any1).values()) == 30);
+static_assert(stdx::scan_any<login_pattern, logout_pattern, error_pattern>("LOGIN user=alice")->index() == 0);
+static_assert(stdx::scan_any<login_pattern, logout_pattern, error_pattern>("ERR -5")->index() == 2);
+static_assert(!stdx::scan_any<login_pattern, logout_pattern, error_pattern>("WARN disk").has_value());
+static_assert(!stdx::scan_any<login_pattern, logout_pattern, error_pattern>("ERR x").has_value());
+// Формат с пустым начальным литералом остаётся кандидатом для любой строки
+static_assert(stdx::scan_any<error_pattern, fallback_pattern>("ERR x")->index() == 1);
+static_assert(stdx::scan_any<error_pattern, fallback_pattern>("ERR 1")->index() == 0);
+
+// Форматы, начинающиеся с плейсхолдера, различаются по литералам после полей фиксированной ширины
+using stdx::details::dispatch_candidates;
+using access_pattern = pattern<"{%10s} {%4s} GET {}"_fs, std::string_view, std::string_view, std::string_view>;
+using upload_pattern = pattern<"{%10s} {%4s} PUT {}"_fs, std::string_view, std::string_view, std::string_view>;
+using audit_pattern = pattern<"{%10s} {%4s}|{%u}"_fs, std::string_view, std::string_view, uint32_t>;
+static_assert(dispatch_candidates<access_pattern, upload_pattern, audit_pattern>("2024-01-31 web1 PUT /a") == 0b010);
+static_assert(dispatch_candidates<access_pattern, upload_pattern, audit_pattern>("2024-01-31 web1|7") == 0b100);
+static_assert(dispatch_candidates<access_pattern, upload_pattern, audit_pattern>("2024-01-31 web1 POST") == 0);
+static_assert(dispatch_candidates<access_pattern, upload_pattern, audit_pattern>("short") == 0);
+static_assert(stdx::scan_any<access_pattern, upload_pattern, audit_pattern>("2024-01-31 web1 PUT /a")->index() == 1);
+static_assert(stdx::scan_any<access_pattern, upload_pattern, audit_pattern>("2024-01-31 web1|7")->index() == 2);
+// Позиции, где все форматы требуют один и тот же байт, в таблицу не попадают
+static_assert(stdx::details::patterns_filter<access_pattern, upload_pattern>.size == 2);
+static_assert(dispatch_candidates<login_pattern, logout_pattern>("LOGOUT user=") == 0b10);
+
+// Литералы после поля без ширины на известных позициях не стоят: такие форматы остаются кандидатами
+// и разбираются по очереди
+using get_pattern = pattern<"{} GET {}"_fs, std::string_view, std::string_view>;
+using put_pattern = pattern<"{} PUT {}"_fs, std::string_view, std::string_view>;
+static_assert(dispatch_candidates<get_pattern, put_pattern>("host PUT /a") == 0b11);
+static_assert(stdx::scan_any<get_pattern, put_pattern>("host PUT /a")->index() == 1);
+static_assert(!stdx::scan_any<get_pattern, put_pattern>("host POST /a").has_value());
+
+// ========== Тестирование разбора многострочных данных ==========
+constexpr auto ports = stdx::scan_all<"{%s} {%u}"_fs, "http 80\nhttps 443\r\n\nssh 22\n", std::string_view, uint16_t>();
+static_assert(ports.size() == 3);
+static_assert(std::get<0>(ports[1].values()) == "https");
+static_assert(std::get<1>(ports[2].values()) == 22);
+static_assert(stdx::scan_all<"{%d}"_fs, "", int>().empty());
+static_assert(std::get<0>(stdx::scan_all<"{%d}"_fs, "1\n-2", const int>()[1].values()) == -2);
+
+// Таблица из 10000 строк вида "port=00042 name=svc00042"
+constexpr std::size_t TABLE_LINES = 10000;
+constexpr std::size_t TABLE_LINE_SIZE = 25;
+
+consteval auto make_port_table() {
+    char text[TABLE_LINES * TABLE_LINE_SIZE + 1] = {};
+    for (std::size_t line = 0; line < TABLE_LINES; ++line) {
+        char* out = text + line * TABLE_LINE_SIZE;
+        constexpr std::string_view pattern = "port=00000 name=svc00000\n";
+        std::copy(pattern.begin(), pattern.end(), out);
+        for (std::size_t digit = 0, value = line; digit < 5; ++digit, value /= 10) {
+            out[9 - digit] = out[23 - digit] = static_cast<char>('0' + value % 10);
+        }
+    }
+    return fixed_string<TABLE_LINES * TABLE_LINE_SIZE + 1>(text);
+}
+
+// Таблица проверяется внутри константного вычисления, чтобы не выводить её в объектный файл
+static_assert([] {
+    constexpr auto table = stdx::scan_all<"port={%u} name={%s}"_fs, make_port_table(), uint32_t, std::string_view>();
+    return table.size() == TABLE_LINES && std::get<0>(table[9999].values()) == 9999 &&
+           std::get<1>(table[42].values()) == "svc00042";
+}());
+
+// ========== Тестирование полей фиксированной ширины ==========
+static_assert("{%4u}{%3s}{%2d}"_fs.plan.placeholders[0].width == 4);
+static_assert("{%4u}{%3s}{%2d}"_fs.plan.fixed);
+static_assert("{%4u}{%3s}{%2d}"_fs.plan.offsets[2] == 7);
+static_assert("[{%4u}] {%3s}"_fs.plan.offsets[1] == 7);
+static_assert("[{%4u}] {%3s}"_fs.plan.record_size == 10);
+static_assert(!"{%3u},{%s}"_fs.plan.fixed);
+
+constexpr auto fixed1 = stdx::scan<"{%4u}{%3s}{%2d}"_fs, "0042abc-5", uint32_t, std::string_view, int8_t>();
+static_assert(std::get<0>(fixed1.values()) == 42);
+static_assert(std::get<1>(fixed1.values()) == "abc");
+static_assert(std::get<2>(fixed1.values()) == -5);
+// Числа, дополненные пробелами до ширины поля
+static_assert(std::get<0>(stdx::scan<"[{%5u}]"_fs, "[  42 ]", uint16_t>().values()) == 42);
+// Поле фиксированной ширины в формате с полями, ограниченными литералами
+constexpr auto fixed2 = stdx::scan<"{%3u},{%s}"_fs, "007,tail", uint32_t, std::string_view>();
+static_assert(std::get<0>(fixed2.values()) == 7 && std::get<1>(fixed2.values()) == "tail");
+
+using stdx::details::parse_source;
+static_assert(std::string_view(parse_source<"{%4u}{%3s}"_fs, uint32_t, std::string_view>("0042ab").error().data) ==
+              "Record length mismatch");
+static_assert(std::string_view(parse_source<"{%2u}-{%2u}"_fs, uint32_t, uint32_t>("12+34").error().data) ==
+              "Literal mismatch");
+static_assert(std::string_view(parse_source<"{%3u},{%s}"_fs, uint32_t, std::string_view>("07,x").error().data) ==
+              "Separator hasn't been found");
+static_assert(std::string_view(parse_source<"{%2u}"_fs, uint8_t>("  ").error().data) ==
+              "Failed to parse integer");
+
+// ========== Тестирование ленивого разбора ==========
+static_assert([] {
+    auto lazy = stdx::scan_lazy<"{%s} {%u} {%d}"_fs, std::string_view, uint16_t, int>("GET 404 x");
+    // Ошибка в третьем поле не мешает прочитать первые два
+    return lazy.has_value() && lazy->get<0>() == "GET" && lazy->get<1>() == 404 && !lazy->get<2>().has_value() &&
+           lazy->field<2>() == "x";
+}());
+static_assert([] {
+    auto lazy = stdx::scan_lazy<"{%4u}|{%2s}"_fs, const uint32_t, std::string_view>("0042|ok");
+    return lazy.has_value() && lazy->get<0>() == 42 && lazy->get<0>() == 42 && lazy->get<1>() == "ok";
+}());
+static_assert(!stdx::scan_lazy<"{%s} {%u}"_fs, std::string_view, uint16_t>("GET").has_value());
+static_assert(!stdx::scan_lazy<"id={%u}"_fs, uint16_t>("ID=1").has_value());
+static_assert(stdx::scan_lazy<"ping"_fs>("ping").has_value());
+
+// ========== Тестирование пропускаемых полей ==========
+static_assert("{%*} {%u}"_fs.number_placeholders == 2);
+static_assert("{%*} {%u}"_fs.number_arguments == 1);
+static_assert("{%*d} {%u} {%*4s}"_fs.plan.placeholders[0].discard);
+static_assert("{%*d} {%u} {%*4s}"_fs.plan.placeholders[2].width == 4);
+static_assert("{%*d} {%u} {%*4s}"_fs.plan.arguments[0] == 1);
+
+constexpr auto skip1 = stdx::scan<"id={%*} user={%s} code={%*d} size={%u}"_fs,
+                                  "id=af03-11 user=bob code=-17 size=512", std::string_view, uint32_t>();
+static_assert(std::get<0>(skip1.values()) == "bob");
+static_assert(std::get<1>(skip1.values()) == 512);
+static_assert(sizeof(skip1) == sizeof(stdx::details::scan_result<std::string_view, uint32_t>));
+// Все поля пропускаются: результат пустой, но строка проверяется
+static_assert(std::tuple_size_v<std::remove_cvref_t<decltype(stdx::scan<"{%*u}-{%*}"_fs, "12-x">().values())>> == 0);
+static_assert(std::get<0>(stdx::scan<"{%*3u}{%2s}"_fs, " 42ok", std::string_view>().values()) == "ok");
+
+static_assert(std::string_view(parse_source<"{%*d} {%u}"_fs, uint32_t>("1x 2").error().data) ==
+              "Failed to parse integer");
+static_assert(std::string_view(parse_source<"{%*u} {%u}"_fs, uint32_t>("-1 2").error().data) ==
+              "Failed to parse integer");
+static_assert(!stdx::scan_lazy<"{%*d},{%u}"_fs, uint32_t>("x,1").has_value());
+static_assert([] {
+    auto lazy = stdx::scan_lazy<"{%*},{%u},{%*d},{%s}"_fs, uint32_t, std::string_view>("skip,7,-3,end");
+    return lazy.has_value() && lazy->get<0>() == 7 && lazy->get<1>() == "end";
+}());
+
+// ========== Тестирование разбора в агрегаты ==========
+struct access_record {
+    std::string_view method;
+    std::string_view path;
+    uint16_t status = 0;
+    uint64_t bytes = 0;
+};
+
+static_assert(stdx::details::count_members<access_record>() == 4);
+static_assert([] {
+    access_record record;
+    const auto result = stdx::scan_into<"{%s} {%s} {%*} {%u} {%u}"_fs>("GET /index.html HTTP/1.1 200 5120", record);
+    return result.has_value() && record.method == "GET" && record.path == "/index.html" && record.status == 200 &&
+           record.bytes == 5120;
+}());
+static_assert([] {
+    access_record record;
+    return !stdx::scan_into<"{%s} {%s} {%u} {%u}"_fs>("GET / 200 -1", record).has_value();
+}());
+
+// ========== Тестирование ключевых слов ==========
+enum class log_level { debug, info, warn, error };
+enum class http_method : uint8_t { get = 1, head = 2, post = 4, put = 8, del = 16 };
+
+template <>
+struct stdx::keywords<log_level> {
+    static constexpr std::array entries = {
+        stdx::keyword{"debug", log_level::debug}, stdx::keyword{"info", log_level::info},
+        stdx::keyword{"warn", log_level::warn}, stdx::keyword{"error", log_level::error}};
+};
+
+// Слова, совпадающие по длине, первому, среднему и последнему символам, хешируются целиком
+template <>
+struct stdx::keywords<http_method> {
+    static constexpr std::array entries = {
+        stdx::keyword{"GET", http_method::get}, stdx::keyword{"HEAD", http_method::head},
+        stdx::keyword{"POST", http_method::post}, stdx::keyword{"PUT", http_method::put},
+        stdx::keyword{"DELETE", http_method::del}, stdx::keyword{"PAST", http_method::put}};
+};
+
+using stdx::details::keyword_table;
+static_assert(keyword_table<log_level>::params.size == 4);
+static_assert(keyword_table<log_level>::params.kind == stdx::details::keyword_hash_kind::sampled);
+static_assert(keyword_table<http_method>::params.kind == stdx::details::keyword_hash_kind::full);
+
+constexpr auto kw1 = stdx::scan<"[{%k}] {%s}"_fs, "[warn] disk is full", log_level, std::string_view>();
+static_assert(std::get<0>(kw1.values()) == log_level::warn);
+static_assert(std::get<0>(stdx::scan<"{} {%u}"_fs, "DELETE 3", http_method, uint32_t>().values()) == http_method::del);
+static_assert(std::get<0>(stdx::scan<"{%5k}|"_fs, "info |", log_level>().values()) == log_level::info);
+static_assert(std::string_view(parse_source<"{%k}"_fs, log_level>("fatal").error().data) == "Unknown keyword");
+static_assert(!parse_source<"{%k}"_fs, log_level>("").has_value());
+static_assert(!parse_source<"{%k}"_fs, log_level>("infx").has_value());
+
+// ========== Тестирование чисел с плавающей точкой ==========
+using stdx::details::parse_float;
+
+// Точное сравнение с литералом: литерал округляется компилятором корректно
+static_assert(parse_float<double>("0.1").value() == 0.1);
+static_assert(parse_float<double>("-2.5").value() == -2.5);
+static_assert(parse_float<double>("1e23").value() == 1e23);
+static_assert(parse_float<double>("123456789012345678").value() == 123456789012345678.0);
+static_assert(parse_float<double>("2.2250738585072011e-308").value() == 2.2250738585072011e-308);
+static_assert(parse_float<double>("4.9406564584124654e-324").value() == 4.9406564584124654e-324);
+static_assert(parse_float<double>("1.7976931348623157e308").value() == 1.7976931348623157e308);
+static_assert(parse_float<double>("0.000000000000000000000000000000001234").value() == 1.234e-33);
+static_assert(parse_float<double>(".5").value() == 0.5);
+static_assert(parse_float<double>("5.").value() == 5.0);
+static_assert(parse_float<double>("1E+2").value() == 100.0);
+static_assert(parse_float<float>("3.14159265").value() == 3.14159265f);
+static_assert(parse_float<float>("1e-45").value() == 1e-45f);
+static_assert(parse_float<float>("3.4028235e38").value() == 3.4028235e38f);
+
+// Середина между 2^53 и 2^53 + 2 округляется к чётному, любая ненулевая цифра дальше - вверх
+static_assert(parse_float<double>("9007199254740993").value() == 9007199254740992.0);
+static_assert(parse_float<double>("9007199254740993.0000000000000000000001").value() == 9007199254740994.0);
+static_assert(parse_float<double>("9007199254740992.9999999999999999999999").value() == 9007199254740992.0);
+static_assert(parse_float<double>("2.47032822920623272088e-324").value() == 0.0);
+static_assert(parse_float<double>("2.47032822920623272089e-324").value() == 4.9406564584124654e-324);
+
+// Переполнение и исчезновение порядка
+static_assert(parse_float<double>("1e309").value() == std::numeric_limits<double>::infinity());
+static_assert(parse_float<double>("-1e-400").value() == 0.0);
+static_assert(parse_float<float>("1e39").value() == std::numeric_limits<float>::infinity());
+static_assert(parse_float<double>("-Infinity").value() == -std::numeric_limits<double>::infinity());
+static_assert(parse_float<double>("nan").value() != parse_float<double>("nan").value());
+
+static_assert(std::string_view(parse_float<double>("").error().data) == "Failed to parse float");
+static_assert(std::string_view(parse_float<double>("1.5x").error().data) == "Extra characters after float");
+static_assert(!parse_float<double>("+1").has_value());
+static_assert(!parse_float<double>(".").has_value());
+static_assert(!parse_float<double>("1e").has_value());
+static_assert(!parse_float<double>(" 1").has_value());
+
+constexpr auto fl1 = stdx::scan<"lat={%f} lon={} alt={%f}"_fs, "lat=55.7558 lon=37.6173 alt=-12.5", double, float, double>();
+static_assert(std::get<0>(fl1.values()) == 55.7558);
+static_assert(std::get<1>(fl1.values()) == 37.6173f);
+static_assert(std::get<2>(fl1.values()) == -12.5);
+static_assert(std::get<0>(stdx::scan<"{%8f}|"_fs, "  1.25  |", double>().values()) == 1.25);
+static_assert(std::get<0>(stdx::scan<"{%*f} {%f}"_fs, "1e5 2e5", double>().values()) == 2e5);
+static_assert(std::string_view(parse_source<"{%*f} {%f}"_fs, double>("x 2e5").error().data) == "Failed to parse float");
+static_assert(std::string_view(stdx::scan_lazy<"{%*f} {%f}"_fs, double>("1e 2e5").error().data) ==
+              "Failed to parse float");
+
+// ========== Тестирование шестнадцатеричных, восьмеричных и двоичных полей ==========
+using trace_id = std::array<uint8_t, 16>;
+
+static_assert(std::get<0>(stdx::scan<"{%x}"_fs, "DeadBeef", uint32_t>().values()) == 0xDEADBEEF);
+static_assert(std::get<0>(stdx::scan<"{%x}"_fs, "0123456789abcdef", uint64_t>().values()) == 0x0123456789ABCDEF);
+static_assert(std::get<0>(stdx::scan<"{%x}"_fs, "00000000000000000ff", uint64_t>().values()) == 0xFF);
+static_assert(std::get<0>(stdx::scan<"{%o}"_fs, "755", uint16_t>().values()) == 0755);
+static_assert(std::get<0>(stdx::scan<"{%b}"_fs, "1011", uint8_t>().values()) == 0b1011);
+static_assert(std::get<0>(stdx::scan<"flags={%4x}|"_fs, "flags=  1f|", uint8_t>().values()) == 0x1F);
+
+constexpr auto hex1 = stdx::scan<"{%x}-{%x}"_fs, "0af7651916cd43dd8448eb211c80319c-00f067aa0ba902b7", trace_id, uint64_t>();
+static_assert(std::get<0>(hex1.values())[0] == 0x0A && std::get<0>(hex1.values())[15] == 0x9C);
+static_assert(std::get<1>(hex1.values()) == 0x00F067AA0BA902B7);
+static_assert(std::get<0>(stdx::scan<"{}"_fs, "0a0B0c0D", std::array<uint8_t, 4>>().values())[1] == 0x0B);
+
+static_assert(std::string_view(parse_source<"{%x}"_fs, uint8_t>("1ff").error().data) == "Failed to parse integer");
+static_assert(parse_source<"{%x}"_fs, uint8_t>("1ff").error().reason == stdx::details::error_reason::overflow);
+static_assert(std::string_view(parse_source<"{%x}"_fs, uint32_t>("12g").error().data) == "Extra characters after integer");
+static_assert(std::string_view(parse_source<"{%x}"_fs, std::array<uint8_t, 2>>("abc").error().data) ==
+              "Hex field length mismatch");
+static_assert(!parse_source<"{%x}"_fs, std::array<uint8_t, 2>>("ab-c").has_value());
+static_assert(!parse_source<"{%x}"_fs, uint32_t>("0x1f").has_value());
+static_assert(!parse_source<"{%o}"_fs, uint32_t>("8").has_value());
+static_assert(!parse_source<"{%b}"_fs, uint32_t>("102").has_value());
+static_assert(!parse_source<"{%x}"_fs, uint32_t>("").has_value());
+static_assert(std::get<0>(stdx::scan<"{%*x} {%u}"_fs, "c0ffee 7", uint32_t>().values()) == 7);
+static_assert(!parse_source<"{%*x} {%u}"_fs, uint32_t>("coffee 7").has_value());
+
+// ========== Тестирование проверки строк без разбора ==========
+using stdx::details::match_line;
+
+static_assert(match_line<"{%s} {%s} {%u} {%u}"_fs>("GET /index.html 200 5120"));
+static_assert(!match_line<"{%s} {%s} {%u} {%u}"_fs>("GET /index.html OK 5120"));
+static_assert(!match_line<"{%s} {%s} {%u} {%u}"_fs>("GET /index.html 200"));
+static_assert(match_line<"{%d}|{%x}|{%f}|{%k}"_fs>("-7|beef|1e-3|anything"));
+static_assert(!match_line<"{%d}|{%x}|{%f}|{%k}"_fs>("-7|beef|1e-|anything"));
+// Диапазон типа не проверяется: типов у match нет
+static_assert(match_line<"{%u}"_fs>("99999999999999999999999"));
+static_assert(match_line<"[{%4u}] {%3s}"_fs>("[  42] abc"));
+static_assert(!match_line<"[{%4u}] {%3s}"_fs>("[0042] abcd"));
+static_assert(!match_line<"[{%4u}] {%3s}"_fs>("(0042) abc"));
+static_assert(match_line<"ping"_fs>("ping"));
+static_assert(!match_line<"ping"_fs>("ping!"));
+
+// ========== Тестирование пользовательских типов через stdx::scanner ==========
+// Длительность в миллисекундах: "250ms"
+struct duration_ms {
+    uint64_t value;
+};
+
+template <>
+struct stdx::scanner<duration_ms> {
+    static constexpr char specifier = 'D';
+
+    static constexpr std::expected<duration_ms, stdx::details::parse_error> parse(std::string_view field) {
+        if (!field.ends_with("ms")) {
+            return std::unexpected(stdx::details::parse_error{"Failed to parse duration"});
+        }
+        const auto value = stdx::details::parse_value<uint64_t>(field.substr(0, field.size() - 2));
+        if (!value) {
+            return std::unexpected(value.error());
+        }
+        return duration_ms{*value};
+    }
+};
+
+using namespace std::chrono_literals;
+using sys_ms = std::chrono::sys_time<std::chrono::milliseconds>;
+using sys_ns = std::chrono::sys_time<std::chrono::nanoseconds>;
+using stdx::details::parse_ipv6;
+using stdx::details::parse_timestamp;
+
+constexpr auto sc1 = stdx::scan<"{%T} {%I} {%D}"_fs, "2024-03-15T12:30:45.123Z 10.0.1.2 250ms", sys_ms,
+                                stdx::ipv4_address, duration_ms>();
+static_assert(std::get<0>(sc1.values()) == sys_ms{std::chrono::sys_days{2024y / 3 / 15} + 12h + 30min + 45s + 123ms});
+static_assert(std::get<1>(sc1.values()).value() == 0x0A000102);
+static_assert(std::get<2>(sc1.values()).value == 250);
+static_assert(std::get<0>(stdx::scan<"{} {}"_fs, "1970-01-01 ::1", sys_ms, stdx::ipv6_address>().values()) == sys_ms{});
+static_assert(std::get<0>(stdx::scan<"[{%12I}]"_fs, "[   127.0.0.1]", stdx::ipv4_address>().values()).value() == 0x7F000001);
+static_assert(std::get<0>(stdx::scan<"{%*T} {%u}"_fs, "2024-03-15 7", uint32_t>().values()) == 7);
+
+// Смещение часового пояса, дробная часть и разделители даты и времени
+static_assert(parse_timestamp<std::chrono::seconds>("2024-03-15T12:30:45+03:00").value() ==
+              std::chrono::sys_seconds{std::chrono::sys_days{2024y / 3 / 15} + 9h + 30min + 45s});
+static_assert(parse_timestamp<std::chrono::seconds>("2024-03-15 00:30:00-0130").value() ==
+              std::chrono::sys_seconds{std::chrono::sys_days{2024y / 3 / 15} + 2h});
+static_assert(parse_timestamp<std::chrono::seconds>("2024-01-01t00:00:00+01").value() ==
+              std::chrono::sys_seconds{std::chrono::sys_days{2023y / 12 / 31} + 23h});
+static_assert(parse_timestamp<std::chrono::nanoseconds>("2024-03-15T12:30:45,123456789123Z").value() ==
+              sys_ns{std::chrono::sys_days{2024y / 3 / 15} + 12h + 30min + 45s + 123456789ns});
+static_assert(parse_timestamp<std::chrono::milliseconds>("1969-12-31T23:59:59.9999Z").value() == sys_ms{-1ms});
+static_assert(parse_timestamp<std::chrono::seconds>("2024-02-29").has_value());
+static_assert(!parse_timestamp<std::chrono::seconds>("2023-02-29").has_value());
+static_assert(!parse_timestamp<std::chrono::seconds>("2024-13-01").has_value());
+static_assert(!parse_timestamp<std::chrono::seconds>("2024-03-15T24:00:00").has_value());
+static_assert(!parse_timestamp<std::chrono::seconds>("2024-03-15T12:30").has_value());
+static_assert(!parse_timestamp<std::chrono::seconds>("2024-03-15T12:30:45.").has_value());
+static_assert(!parse_timestamp<std::chrono::seconds>("2024-03-15T12:30:45+3").has_value());
+static_assert(!parse_timestamp<std::chrono::seconds>("2024-03-15T12:30:45+03:0").has_value());
+static_assert(!parse_timestamp<std::chrono::seconds>("2024-3-15").has_value());
+static_assert(std::string_view(parse_source<"{%T}"_fs, sys_ms>("yesterday").error().data) ==
+              "Failed to parse timestamp");
+
+// Записи IPv4 и IPv6, включая сокращение '::' в начале, середине и конце и IPv4 в последних 32 битах
+constexpr auto ipv6_bytes(std::string_view str) {
+    return parse_ipv6(str).value().bytes;
+}
+static_assert(ipv6_bytes("::") == std::array<uint8_t, 16>{});
+static_assert(ipv6_bytes("::1")[15] == 1 && ipv6_bytes("::1")[14] == 0);
+static_assert(ipv6_bytes("1::")[1] == 1 && ipv6_bytes("1::")[15] == 0);
+static_assert(ipv6_bytes("2001:db8::8a2e:370:7334") ==
+              std::array<uint8_t, 16>{0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0, 0, 0, 0x8a, 0x2e, 0x03, 0x70, 0x73, 0x34});
+static_assert(ipv6_bytes("::FFFF:10.0.0.1") ==
+              std::array<uint8_t, 16>{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff, 10, 0, 0, 1});
+static_assert(ipv6_bytes("1:2:3:4:5:6:7:8")[15] == 8);
+static_assert(!parse_ipv6(":::").has_value());
+static_assert(!parse_ipv6("1:2:3:4:5:6:7:8:9").has_value());
+static_assert(!parse_ipv6("1:2:3:4:5:6:7").has_value());
+static_assert(!parse_ipv6("1::2::3").has_value());
+static_assert(!parse_ipv6("1:2:3:4:5:6:7::8").has_value());
+static_assert(!parse_ipv6("1:2:3:4:5:6:7:8::").has_value());
+static_assert(ipv6_bytes("1:2:3:4:5:6:7::")[13] == 7 && ipv6_bytes("1:2:3:4:5:6:7::")[15] == 0);
+static_assert(ipv6_bytes("::2:3:4:5:6:7:8")[1] == 0 && ipv6_bytes("::2:3:4:5:6:7:8")[15] == 8);
+static_assert(!parse_ipv6("12345::").has_value());
+static_assert(!parse_ipv6("1:").has_value());
+static_assert(!parse_ipv6(":1").has_value());
+static_assert(!parse_ipv6("1:2:3:4:5:6:7:1.2.3.4").has_value());
+static_assert(!parse_ipv6("::1.2.3.04").has_value());
+static_assert(!parse_ipv6("fe80::1%eth0").has_value());
+static_assert(!parse_source<"{%I}"_fs, stdx::ipv4_address>("10.0.0.256").has_value());
+static_assert(!parse_source<"{%I}"_fs, stdx::ipv4_address>("10.0.0.01").has_value());
+static_assert(!parse_source<"{%I}"_fs, stdx::ipv4_address>("10.0.0").has_value());
+static_assert(!parse_source<"{%I}"_fs, stdx::ipv4_address>("10.0.0.1.").has_value());
+static_assert(std::string_view(parse_source<"{%I}"_fs, stdx::ipv4_address>("::1").error().data) ==
+              "Failed to parse IPv4 address");
+static_assert(std::string_view(parse_source<"{%D}"_fs, duration_ms>("250s").error().data) == "Failed to parse duration");
+
 // ========== Тесты, которые должны вызывать ошибки компиляции ==========
 // спецификатор '%d' требует знаковый целочисленный тип
 // constexpr auto test_spec_error1 = stdx::scan<"{%d}"_fs, "123", unsigned int>();
@@ -211,13 +683,19 @@ constexpr auto test_spec_match5 = stdx::scan<"{%s}"_fs, "hello", std::string_vie
 // спецификатор '%d' с std::string_view
 // constexpr auto test_spec_error5 = stdx::scan<"{%d}"_fs, "text", std::string_view>();
 
+// спецификатор '%T' требует тип со stdx::scanner с тем же спецификатором
+// constexpr auto test_spec_error6 = stdx::scan<"{%T}"_fs, "2024-03-15", uint32_t>();
+// constexpr auto test_spec_error7 = stdx::scan<"{%D}"_fs, "10.0.0.1", stdx::ipv4_address>();
+
+// ленивый разбор проверяет соответствие спецификаторов типам всех полей, а не только прочитанных через get<I>()
+// const auto test_spec_error8 = stdx::scan_lazy<"{%d}"_fs, unsigned int>("1");
+
 // ========== Тесты НЕ поддерживаемых типов (вызывают ошибки компиляции) ==========
 // 1. std::string (должен быть string_view)
 // constexpr auto test_string = stdx::scan<"{}"_fs, "test", std::string>();
 
-// 2. Числа с плавающей точкой
-// constexpr auto test_float = stdx::scan<"{}"_fs, "3.14", float>();
-// constexpr auto test_double = stdx::scan<"{}"_fs, "3.14", double>();
+// 2. long double
+// constexpr auto test_long_double = stdx::scan<"{}"_fs, "3.14", long double>();
 
 // 3. Ссылочные типы
 // constexpr auto test_int_ref = stdx::scan<"{}"_fs, "42", int&>();
@@ -237,7 +715,764 @@ constexpr auto test_spec_match5 = stdx::scan<"{%s}"_fs, "hello", std::string_vie
 // 7. char
 // constexpr auto test_char = stdx::scan<"{}"_fs, "a", char>();
 
+// Проверка runtime-версии scan на данных, неизвестных в compile-time
+// число сохраняемых плейсхолдеров должно совпадать с числом полей записи
+// access_record record; auto test_into = stdx::scan_into<"{%s} {%s}"_fs>("a b", record);
+
+// спецификатор '%k' требует перечисление со списком stdx::keywords
+// constexpr auto test_keyword = stdx::scan<"{%k}"_fs, "info", std::string_view>();
+
+// спецификатор '%f' требует float или double
+// constexpr auto test_float_spec = stdx::scan<"{%f}"_fs, "3", int>();
+
+// спецификаторы '%x', '%o' и '%b' требуют беззнаковый тип
+// constexpr auto test_hex_signed = stdx::scan<"{%x}"_fs, "ff", int>();
+// constexpr auto test_octal_bytes = stdx::scan<"{%o}"_fs, "17", std::array<uint8_t, 1>>();
+
+// пропускаемые поля не требуют типа в Ts...
+// constexpr auto test_discard_type = stdx::scan<"{%*d} {%u}"_fs, "1 2", int, unsigned int>();
+
+// ширина поля должна быть положительной
+// constexpr auto test_zero_width = stdx::scan<"{%0u}"_fs, "1", unsigned int>();
+
+// интернировать можно только строковые аргументы
+// stdx::scan_arena arena; auto test_intern = stdx::scan_owned<"{%s} {%u}"_fs, stdx::intern<1>, std::string_view, unsigned int>("a 1", arena);
+
+void test_runtime_scan() {
+    const std::string line = "GET /index.html 200 5120";
+    const auto result =
+        stdx::scan<"{%s} {%s} {%u} {%u}"_fs, std::string_view, std::string_view, uint16_t, uint64_t>(line);
+    assert(result.has_value());
+    assert(std::get<0>(result->values()) == "GET");
+    assert(std::get<1>(result->values()) == "/index.html");
+    assert(std::get<2>(result->values()) == 200);
+    assert(std::get<3>(result->values()) == 5120);
+
+    const auto failed = stdx::scan<"{%s} {%u}"_fs, std::string_view, uint16_t>(std::string("GET x"));
+    assert(!failed.has_value());
+}
+
+// Проверка векторизованного разбора длинных чисел
+void test_parse_integer() {
+    const std::string max_u64 = "18446744073709551615";
+    assert(parse_integer<uint64_t>(max_u64).value() == 18446744073709551615ULL);
+    assert(!parse_integer<uint64_t>(max_u64 + "0").has_value());
+    assert(parse_integer<uint64_t>(std::string("1234567890123456")).value() == 1234567890123456ULL);
+    assert(parse_integer<int64_t>(std::string("-1234567890123456789")).value() == -1234567890123456789LL);
+    assert(parse_integer<uint32_t>(std::string("00000000000000000000004294967295")).value() == 4294967295u);
+    assert(!parse_integer<uint32_t>(std::string("4294967296")).has_value());
+    assert(!parse_integer<uint64_t>(std::string("12345678901234567x")).has_value());
+    assert(!parse_integer<int32_t>(std::string("12345678x")).has_value());
+}
+
+// Сравнение векторизованного поиска литералов со std::string_view::find
+template <fixed_string Literal>
+void check_literal_searcher(std::string_view haystack) {
+    const std::string_view literal(Literal.data, Literal.size() - 1);
+    for (std::size_t pos = 0; pos <= haystack.size() + 1; ++pos) {
+        assert(literal_searcher<Literal>::find(haystack, pos) == haystack.find(literal, pos));
+    }
+}
+
+void test_literal_searcher() {
+    std::string haystack;
+    for (std::size_t i = 0; i < 300; ++i) {
+        haystack += static_cast<char>('a' + (i * 7 + i / 13) % 5);
+        if (i % 37 == 0) {
+            haystack += " | the quick brown fox | ";
+        }
+    }
+
+    check_literal_searcher<"|">(haystack);
+    check_literal_searcher<"e">(haystack);
+    check_literal_searcher<"ab">(haystack);
+    check_literal_searcher<" | ">(haystack);
+    check_literal_searcher<"quick brown">(haystack);
+    check_literal_searcher<" | the quick brown fox | ">(haystack);
+    check_literal_searcher<"not present at all, long">(haystack);
+    check_literal_searcher<"z">(haystack);
+}
+
+// Проверка пакетного разбора строк буфера и отображённого в память файла
+void test_scan_lines() {
+    constexpr std::string_view log = "GET 200 512\nPOST 201 64\r\nbroken line\nPUT 204 0";
+
+    std::vector<std::string_view> methods;
+    uint64_t total_bytes = 0;
+    const auto stats = stdx::scan_lines<"{%s} {%u} {%u}"_fs, std::string_view, uint16_t, uint64_t>(
+        log, [&](const auto& record) {
+            methods.push_back(std::get<0>(record.values()));
+            total_bytes += std::get<2>(record.values());
+        });
+    assert(stats.matched == 3);
+    assert(stats.failed == 1);
+    assert((methods == std::vector<std::string_view>{"GET", "POST", "PUT"}));
+    assert(total_bytes == 576);
+
+    const auto path = std::filesystem::temp_directory_path() / "scan_tests_lines.log";
+    std::ofstream(path) << log << '\n';
+    std::size_t records = 0;
+    const auto file_stats = stdx::scan_file<"{%s} {%u} {%u}"_fs, std::string_view, uint16_t, uint64_t>(
+        path, [&](const auto&) { ++records; });
+    std::filesystem::remove(path);
+    assert(file_stats.has_value());
+    assert(file_stats->matched == 3 && file_stats->failed == 1 && records == 3);
+
+    const auto missing = stdx::scan_file<"{}"_fs, std::string_view>(path, [](const auto&) {});
+    assert(!missing.has_value());
+}
+
+// Проверка совпадения параллельного разбора с последовательным
+void test_scan_lines_parallel() {
+    std::string log;
+    for (int i = 0; i < 1000; ++i) {
+        log += (i % 7 == 0) ? "broken\n" : "id=" + std::to_string(i) + " user=u" + std::to_string(i % 13) + "\n";
+    }
+
+    using record = stdx::details::scan_result<uint32_t, std::string_view>;
+    std::vector<record> serial;
+    const auto serial_stats = stdx::scan_lines<"id={%u} user={%s}"_fs, uint32_t, std::string_view>(
+        log, [&](const record& r) { serial.push_back(r); });
+
+    for (const auto order : {stdx::details::merge_order::input, stdx::details::merge_order::unordered}) {
+        const auto parallel = stdx::scan_lines_parallel<"id={%u} user={%s}"_fs, uint32_t, std::string_view>(
+            log, {.threads = 4, .chunk_size = 100, .order = order});
+        assert(parallel.stats.matched == serial_stats.matched);
+        assert(parallel.stats.failed == serial_stats.failed);
+        assert(parallel.records.size() == serial.size());
+
+        uint64_t serial_sum = 0, parallel_sum = 0;
+        for (std::size_t i = 0; i < serial.size(); ++i) {
+            serial_sum += std::get<0>(serial[i].values());
+            parallel_sum += std::get<0>(parallel.records[i].values());
+            if (order == stdx::details::merge_order::input) {
+                assert(parallel.records[i].values() == serial[i].values());
+            }
+        }
+        assert(serial_sum == parallel_sum);
+    }
+
+    const auto path = std::filesystem::temp_directory_path() / "scan_tests_parallel.log";
+    std::ofstream(path) << log;
+    const auto from_file = stdx::scan_file_parallel<"id={%u} user={%s}"_fs, uint32_t, std::string_view>(
+        path, {.threads = 3, .chunk_size = 256});
+    std::filesystem::remove(path);
+    assert(from_file.has_value());
+    assert(from_file->records.size() == serial.size());
+    assert(from_file->records.back().values() == serial.back().values());
+}
+
+// Проверка столбцового хранения результатов
+void test_scan_columns() {
+    const std::string log = "GET 200 512\nPOST 201 64\nbroken\nPUT 204 0\n";
+    const auto columns = stdx::scan_lines_columnar<"{%s} {%u} {%u}"_fs, std::string_view, uint16_t, uint64_t>(log);
+    assert(columns.size() == 3);
+
+    const auto statuses = columns.column<1>();
+    assert((std::vector<uint16_t>(statuses.begin(), statuses.end()) == std::vector<uint16_t>{200, 201, 204}));
+
+    uint64_t total_bytes = 0;
+    for (const uint64_t bytes : columns.column<2>()) {
+        total_bytes += bytes;
+    }
+    assert(total_bytes == 576);
+
+    const auto methods = columns.column<0>();
+    assert(methods[1].offset == 12 && methods[1].length == 4);
+    assert(columns.resolve(methods[1]) == "POST");
+    assert(columns.get<0>(2) == "PUT");
+    assert(columns.get<1>(0) == 200);
+}
+
+// Проверка потокового разбора при любом разбиении входа на буферы
+void test_stream_scanner() {
+    const std::string log = "id=1 user=alice\nid=2 user=bob\r\nbroken\n\nid=300 user=carol";
+
+    using record = stdx::details::scan_result<uint32_t, std::string_view>;
+    std::vector<std::pair<uint32_t, std::string>> expected;
+    const auto expected_stats = stdx::scan_lines<"id={%u} user={%s}"_fs, uint32_t, std::string_view>(
+        log, [&](const record& r) { expected.emplace_back(std::get<0>(r.values()), std::get<1>(r.values())); });
+
+    for (std::size_t chunk_size = 1; chunk_size <= log.size(); ++chunk_size) {
+        stdx::stream_scanner<"id={%u} user={%s}"_fs, uint32_t, std::string_view> scanner;
+        std::vector<std::pair<uint32_t, std::string>> records;
+        const auto collect = [&](const record& r) {
+            records.emplace_back(std::get<0>(r.values()), std::get<1>(r.values()));
+        };
+
+        for (std::size_t pos = 0; pos < log.size(); pos += chunk_size) {
+            const std::string chunk = log.substr(pos, chunk_size);
+            scanner.feed(chunk, collect);
+        }
+        scanner.finish(collect);
+
+        assert(records == expected);
+        assert(scanner.stats().matched == expected_stats.matched);
+        assert(scanner.stats().failed == expected_stats.failed);
+        assert(scanner.carry_capacity() <= 32);
+    }
+}
+
+// Проверка разбора файлового дескриптора с чтением впрок при любом размере буфера и для канала
+void test_scan_stream() {
+    std::string log;
+    for (int i = 0; i < 200; ++i) {
+        log += (i % 9 == 0) ? "broken\r\n" : "id=" + std::to_string(i) + " user=u" + std::to_string(i % 5) + "\n";
+    }
+    log += "id=1000 user=last";
+
+    using record = stdx::details::scan_result<uint32_t, std::string_view>;
+    std::vector<std::pair<uint32_t, std::string>> expected;
+    const auto expected_stats = stdx::scan_lines<"id={%u} user={%s}"_fs, uint32_t, std::string_view>(
+        log, [&](const record& r) { expected.emplace_back(std::get<0>(r.values()), std::get<1>(r.values())); });
+
+    // Уникальное имя файла: тесты могут запускаться одновременно
+    std::string path = (std::filesystem::temp_directory_path() / "scan_tests_stream_XXXXXX").string();
+    const int file = ::mkstemp(path.data());
+    assert(file >= 0);
+    const ssize_t written = ::write(file, log.data(), log.size());
+    ::close(file);
+    assert(written == static_cast<ssize_t>(log.size()));
+    for (const std::size_t buffer_size : {1, 7, 64, 1000, 1 << 16}) {
+        for (const std::size_t depth : {2, 3}) {
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            assert(fd >= 0);
+            std::vector<std::pair<uint32_t, std::string>> records;
+            const auto stats = stdx::scan_stream<"id={%u} user={%s}"_fs, uint32_t, std::string_view>(
+                fd, [&](const record& r) { records.emplace_back(std::get<0>(r.values()), std::get<1>(r.values())); },
+                {.buffer_size = buffer_size, .depth = depth});
+            ::close(fd);
+            assert(stats.has_value());
+            assert(stats->matched == expected_stats.matched && stats->failed == expected_stats.failed);
+            assert(records == expected);
+        }
+    }
+
+#if defined(__cpp_lib_generator)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    std::vector<std::pair<uint32_t, std::string>> generated;
+    for (const auto& r : stdx::scan_stream<"id={%u} user={%s}"_fs, uint32_t, std::string_view>(fd, {.buffer_size = 7})) {
+        generated.emplace_back(std::get<0>(r.values()), std::get<1>(r.values()));
+    }
+    ::close(fd);
+    assert(generated == expected);
+#endif
+    std::filesystem::remove(path);
+
+    // Канал не поддерживает pread, читатель переходит на read
+    int pipe_fds[2];
+    const int piped_ok = ::pipe(pipe_fds);
+    assert(piped_ok == 0);
+    std::thread writer([&] {
+        for (std::size_t pos = 0; pos < log.size(); pos += 100) {
+            const std::string_view part = std::string_view(log).substr(pos, 100);
+            const ssize_t sent = ::write(pipe_fds[1], part.data(), part.size());
+            assert(sent == static_cast<ssize_t>(part.size()));
+        }
+        ::close(pipe_fds[1]);
+    });
+    std::size_t piped = 0;
+    const auto pipe_stats = stdx::scan_stream<"id={%u} user={%s}"_fs, uint32_t, std::string_view>(
+        pipe_fds[0], [&](const record&) { ++piped; }, {.buffer_size = 64, .depth = 2});
+    writer.join();
+    ::close(pipe_fds[0]);
+    assert(pipe_stats.has_value() && piped == expected.size());
+
+    // Досрочный выход, пока пишущая сторона канала открыта и не присылает данных: читатель, ждущий данных,
+    // прерывается при разрушении, а не ждёт закрытия канала
+    int open_fds[2];
+    const int open_ok = ::pipe(open_fds);
+    assert(open_ok == 0);
+    const std::string_view first = "id=1 user=a\n";
+    const ssize_t sent = ::write(open_fds[1], first.data(), first.size());
+    assert(sent == static_cast<ssize_t>(first.size()));
+    bool stopped = false;
+    try {
+        stdx::scan_stream<"id={%u} user={%s}"_fs, uint32_t, std::string_view>(
+            open_fds[0], [](const record&) { throw std::runtime_error("stop"); }, {.buffer_size = 12, .depth = 2});
+    } catch (const std::runtime_error&) {
+        stopped = true;
+    }
+    assert(stopped);
+#if defined(__cpp_lib_generator)
+    const std::string_view second = "id=2 user=b\n";
+    const ssize_t resent = ::write(open_fds[1], second.data(), second.size());
+    assert(resent == static_cast<ssize_t>(second.size()));
+    for (const auto& r : stdx::scan_stream<"id={%u} user={%s}"_fs, uint32_t, std::string_view>(open_fds[0])) {
+        assert(std::get<0>(r.values()) == 2);
+        break;
+    }
+#endif
+    ::close(open_fds[0]);
+    ::close(open_fds[1]);
+
+    const auto invalid = stdx::scan_stream<"{}"_fs, std::string_view>(-1, [](const auto&) {});
+    assert(!invalid.has_value() && invalid.error() == std::errc::bad_file_descriptor);
+}
+
+// Проверка разбора несколькими форматами на данных, неизвестных в compile-time
+void test_scan_any() {
+    const std::string lines[] = {"LOGIN user=alice", "LOGOUT user=alice after=42s", "ERR 7", "junk"};
+    std::size_t indices[4] = {};
+    for (std::size_t i = 0; i < 4; ++i) {
+        const auto result = stdx::scan_any<login_pattern, logout_pattern, error_pattern>(lines[i]);
+        indices[i] = result ? result->index() : 3;
+    }
+    assert(indices[0] == 0 && indices[1] == 1 && indices[2] == 2 && indices[3] == 3);
+}
+
+// Проверка разбора полей фиксированной ширины в runtime, в том числе блоками по 8 цифр
+void test_fixed_width() {
+    const std::string line = "20240131 000000000123456789|ok";
+    const auto result = stdx::scan<"{%8u} {%18u}|{%2s}"_fs, uint32_t, uint64_t, std::string_view>(line);
+    assert(result.has_value());
+    assert(std::get<0>(result->values()) == 20240131);
+    assert(std::get<1>(result->values()) == 123456789);
+    assert(std::get<2>(result->values()) == "ok");
+
+    assert(!(stdx::scan<"{%8u}"_fs, uint32_t>(std::string("2024013x")).has_value()));
+    assert(!(stdx::scan<"{%8u}"_fs, uint32_t>(std::string("202401311")).has_value()));
+    assert(std::get<0>(stdx::scan<"{%8d}"_fs, int32_t>(std::string("   -1234"))->values()) == -1234);
+}
+
+// Проверка ленивого разбора в runtime: значение поля вычисляется один раз и запоминается
+void test_scan_lazy() {
+    const std::string line = "2024-01-31 level=warn latency=1234 user=alice";
+    auto lazy =
+        stdx::scan_lazy<"{%s} level={%s} latency={%u} user={%s}"_fs, std::string_view, std::string_view, uint32_t,
+                        std::string_view>(line);
+    assert(lazy.has_value());
+    assert(lazy->get<1>() == "warn");
+    assert(lazy->get<2>() == 1234u);
+    assert(lazy->get<2>() == 1234u);
+    assert(lazy->field<3>() == "alice");
+
+    assert(!(stdx::scan_lazy<"{%s} {%u}"_fs, std::string_view, uint32_t>(std::string("a-b")).has_value()));
+}
+
+// Проверка пропускаемых полей в runtime
+void test_discard_fields() {
+    const std::string line = "7f3a9c01 GET /api 200 -";
+    const auto result = stdx::scan<"{%*} {%s} {%s} {%*u} {%*}"_fs, std::string_view, std::string_view>(line);
+    assert(result.has_value());
+    assert(std::get<1>(result->values()) == "/api");
+    assert(!(stdx::scan<"{%*} {%s} {%s} {%*u} {%*}"_fs, std::string_view, std::string_view>(
+                 std::string("7f3a9c01 GET /api OK -"))
+                 .has_value()));
+}
+
+// Проверка пакетного разбора строк в массив записей
+void test_scan_into() {
+    const std::string buffer = "GET / 200 10\nbroken\nPOST /api 201 20\r\nGET /x 404 0\n";
+    std::vector<access_record> records(2);
+    const auto stats = stdx::scan_into<"{%s} {%s} {%u} {%u}"_fs>(buffer, std::span<access_record>(records));
+    assert(stats.matched == 2 && stats.failed == 1);
+    assert(records[0].status == 200);
+    assert(records[1].path == "/api" && records[1].bytes == 20);
+
+    assert(stdx::scan_into<"{%s} {%s} {%u} {%u}"_fs>(buffer, std::span<access_record>()).matched == 0);
+
+    // for_each_line обходит все строки независимо от результата on_line, for_each_line_until - до первого false
+    std::size_t visited = 0;
+    stdx::details::for_each_line(buffer, [&](std::string_view) { return ++visited > 10; });
+    assert(visited == 4);
+    visited = 0;
+    stdx::details::for_each_line_until(buffer, [&](std::string_view line) {
+        ++visited;
+        return line != "broken";
+    });
+    assert(visited == 2);
+}
+
+// Проверка разбора ключевых слов в runtime
+void test_keywords() {
+    const std::string lines[] = {"debug", "info", "warn", "error", "trace", "warning"};
+    int found = 0;
+    for (const auto& line : lines) {
+        const auto result = stdx::scan<"{%k}"_fs, log_level>(line);
+        found += result.has_value() ? 1 : 0;
+    }
+    assert(found == 4);
+    assert(std::get<0>(stdx::scan<"{%k}"_fs, http_method>(std::string("PAST"))->values()) == http_method::put);
+}
+
+// Сравнение с std::from_chars на записях случайных double и float: кратчайшей и с 25 знаками после запятой
+template <typename T>
+void check_float_text(std::string_view text) {
+    T expected = 0;
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), expected);
+    const auto parsed = stdx::scan<"{%f}"_fs, T>(text);
+    // Вне диапазона типа from_chars возвращает ошибку, а scan - бесконечность или ноль
+    assert(parsed.has_value());
+    assert(ec != std::errc{} || std::get<0>(parsed->values()) == expected);
+}
+
+void test_floats() {
+    std::uint64_t state = 0x9E3779B97F4A7C15;
+    const auto next = [&] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    char buffer[64];
+    for (int i = 0; i < 20000; ++i) {
+        const auto bits = next();
+        const double values[] = {std::bit_cast<double>(bits), std::bit_cast<float>(static_cast<std::uint32_t>(bits))};
+        for (const double value : values) {
+            if (!std::isfinite(value)) {
+                continue;
+            }
+            const auto shortest = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+            check_float_text<double>(std::string_view(buffer, shortest - buffer));
+            check_float_text<float>(std::string_view(buffer, shortest - buffer));
+            const auto long_text = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::scientific, 25).ptr;
+            check_float_text<double>(std::string_view(buffer, long_text - buffer));
+            check_float_text<float>(std::string_view(buffer, long_text - buffer));
+        }
+    }
+
+    const std::string line = "latency=0.00042 price=1234.5678";
+    const auto result = stdx::scan<"latency={%f} price={%f}"_fs, float, double>(line);
+    assert(result.has_value());
+    assert(std::get<0>(result->values()) == 0.00042f);
+    assert(std::get<1>(result->values()) == 1234.5678);
+}
+
+// Проверка шестнадцатеричных полей всех длин на случайных значениях и с ошибкой в каждой позиции
+void test_radix() {
+    std::uint64_t state = 0x2545F4914F6CDD1D;
+    const auto next = [&] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    constexpr char digits[] = "0123456789abcdefABCDEF";
+    for (int i = 0; i < 20000; ++i) {
+        std::string text(1 + next() % 20, '0');
+        for (auto& c : text) {
+            c = digits[next() % 22];
+        }
+        std::uint64_t expected = 0;
+        const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), expected, 16);
+        const auto parsed = stdx::scan<"{%x}"_fs, uint64_t>(text);
+        assert(parsed.has_value() == (ec == std::errc{}));
+        assert(!parsed || std::get<0>(parsed->values()) == expected);
+
+        text[next() % text.size()] = "g -x"[next() % 4];
+        assert(!(stdx::scan<"{%x}"_fs, uint64_t>(text).has_value()));
+    }
+
+    const std::string line = "trace=4bf92f3577b34da6a3ce929d0e0e4736 span=00f067aa0ba902b7 mode=644 mask=10100000";
+    std::array<uint8_t, 16> trace{};
+    uint64_t span = 0;
+    uint16_t mode = 0;
+    uint8_t mask = 0;
+    const auto result = stdx::scan<"trace={%x} span={%x} mode={%o} mask={%b}"_fs, std::array<uint8_t, 16>, uint64_t,
+                                   uint16_t, uint8_t>(line);
+    assert(result.has_value());
+    std::tie(trace, span, mode, mask) = result->values();
+    assert(trace[0] == 0x4B && trace[7] == 0xA6 && trace[8] == 0xA3 && trace[15] == 0x36);
+    assert(span == 0x00F067AA0BA902B7 && mode == 0644 && mask == 0b10100000);
+
+    std::string broken = line;
+    broken[6 + 20] = 'z';
+    assert(!(stdx::scan<"trace={%x} span={%x} mode={%o} mask={%b}"_fs, std::array<uint8_t, 16>, uint64_t, uint16_t,
+                        uint8_t>(broken)
+                 .has_value()));
+}
+
+// Сравнение битовой карты match с построчной проверкой match_line на буферах из строк sample,
+// в которых часть байтов заменена разделителями строк, цифрами и байтами других полей
+template <auto Fmt>
+void check_match_lines(std::string_view sample, std::uint64_t& state) {
+    const auto next = [&] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    constexpr std::string_view alphabet = "\n\r0a1.-x7e ";
+    for (int round = 0; round < 200; ++round) {
+        std::string text;
+        for (int i = 0; i < 40; ++i) {
+            for (const char c : sample) {
+                text += next() % 8 == 0 ? alphabet[next() % alphabet.size()] : c;
+            }
+            text += '\n';
+        }
+        if (next() % 2 == 0) {
+            text.pop_back();
+        }
+        std::vector<bool> scalar;
+        stdx::details::for_each_line(text, [&](std::string_view line) {
+            scalar.push_back(stdx::details::match_line<Fmt>(line));
+        });
+        const auto vector = stdx::match<Fmt>(text);
+        assert(vector.size() == scalar.size());
+        for (std::size_t i = 0; i < scalar.size(); ++i) {
+            assert(vector.test(i) == scalar[i]);
+        }
+    }
+}
+
+// Проверка битовой карты match на записях фиксированной длины, включая векторный путь и строки,
+// которые векторная проверка пропускает в скалярную: другой длины, с '\r', со знаком и пробелами
+void test_match() {
+    std::uint64_t state = 0x853C49E6748FEA9B;
+    const auto next = [&] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    const std::string samples[] = {"12:ab", "07:zz", "-1:ab", " 3:ab", "12:abc", "1x:ab", "12;ab", "12:ab\r", "", "99:9f"};
+    std::string buffer;
+    std::vector<std::string> lines;
+    for (int i = 0; i < 5000; ++i) {
+        lines.push_back(next() % 4 == 0 ? samples[next() % std::size(samples)] : samples[next() % 2]);
+        buffer += lines.back();
+        buffer += '\n';
+    }
+    buffer.pop_back();
+
+    const auto bitmap = stdx::match<"{%2d}:{%2s}"_fs>(buffer);
+    assert(bitmap.size() == lines.size());
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        std::string_view line = lines[i];
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+        const bool parsed = stdx::scan<"{%2d}:{%2s}"_fs, int8_t, std::string_view>(line).has_value();
+        assert(bitmap.test(i) == parsed);
+        expected += parsed ? 1 : 0;
+    }
+    assert(bitmap.count() == expected);
+
+    // Поля, форма которых проверяется скалярно после векторной проверки литералов
+    const auto hex = stdx::match<"{%4x}"_fs>(std::string_view("00ff\n00fg\n00FF\n0x1f\n1234\n"));
+    assert(hex.size() == 5 && hex.count() == 3 && !hex.test(1) && !hex.test(3));
+
+    const std::vector<std::string_view> requests = {"GET / 200 10", "broken", "POST /api 201 20"};
+    const auto access = stdx::match<"{%s} {%s} {%u} {%u}"_fs>(std::span<const std::string_view>(requests));
+    assert(access.size() == 3 && access.test(0) && !access.test(1) && access.test(2));
+    assert(stdx::match<"{%u}"_fs>(std::string_view()).size() == 0);
+
+    // Последняя строка без завершающего '\n' длиннее блока векторной проверки
+    std::string unterminated;
+    for (int i = 0; i < 8; ++i) {
+        unterminated += "123\n";
+    }
+    unterminated += std::string(40, 'x');
+    const auto tail = stdx::match<"{%3d}"_fs>(unterminated);
+    assert(tail.size() == 9 && tail.count() == 8 && !tail.test(8));
+
+    // '\n' и '\r' внутри полей делят буфер на строки так же, как скалярная проверка
+    const auto split = stdx::match<"x{%2x}-{%3u}"_fs>(std::string_view("x\r\n-841\nx045491 "));
+    assert(split.size() == 3 && split.count() == 0);
+    check_match_lines<"{%2s}|{%1u}"_fs>("ab|1", state);
+    check_match_lines<"x{%2x}-{%3u}"_fs>("x0f-123", state);
+    check_match_lines<"{%3o}:{%2b}"_fs>("755:10", state);
+    check_match_lines<"{%4f};{%1d}"_fs>("1e-3;7", state);
+    check_match_lines<"{%2u}{%3x}"_fs>("12abc", state);
+}
+
+void test_instrumentation() {
+    constexpr auto fmt = "id={%u} level={%s} size={%u}"_fs;
+    using policy = stdx::instrumented<>;
+    assert((stdx::scan<fmt, policy, uint32_t, std::string_view, uint16_t>("id=1 level=info size=20")));
+    assert((stdx::scan<fmt, policy, uint32_t, std::string_view, uint16_t>("id=2 level=warn size=30")));
+    assert(!(stdx::scan<fmt, policy, uint32_t, std::string_view, uint16_t>("ID=3 level=info size=40")));
+    assert(!(stdx::scan<fmt, policy, uint32_t, std::string_view, uint16_t>("id=x level=info size=50")));
+    assert(!(stdx::scan<fmt, policy, uint32_t, std::string_view, uint16_t>("id=4 level=info")));
+    assert(!(stdx::scan<fmt, policy, uint32_t, std::string_view, uint16_t>("id=5 level=info size=70000")));
+    assert(!(stdx::scan<fmt, policy, uint32_t, std::string_view, uint16_t>("id=7 level=info size=9x")));
+
+    const auto counters = stdx::scan_counters<fmt>();
+    assert(counters.format == "id={%u} level={%s} size={%u}");
+    assert(counters.matched == 2 && counters.failed == 5);
+    assert(counters.bytes == 23 + 23 + 23 + 23 + 15 + 26 + 23);
+    assert(counters.literal_failures == 1);
+    assert(counters.fields.size() == 3);
+    assert(counters.fields[0].separator == 0 && counters.fields[0].conversion == 1);
+    assert(counters.fields[1].separator == 1 && counters.fields[1].conversion == 0);
+    assert(counters.fields[2].separator == 0 && counters.fields[2].conversion == 2);
+    using stdx::details::error_reason;
+    constexpr auto separator = static_cast<std::size_t>(stdx::details::parse_stage::separator);
+    constexpr auto conversion = static_cast<std::size_t>(stdx::details::parse_stage::conversion);
+    assert(counters.fields[0].reasons[conversion][static_cast<std::size_t>(error_reason::syntax)] == 1);
+    assert(counters.fields[1].reasons[separator][static_cast<std::size_t>(error_reason::literal)] == 1);
+    assert(counters.fields[2].reasons[conversion][static_cast<std::size_t>(error_reason::overflow)] == 1);
+    assert(counters.fields[2].reasons[conversion][static_cast<std::size_t>(error_reason::extra)] == 1);
+    assert(counters.sampled == 0 && counters.separator_cycles == 0 && counters.conversion_cycles == 0);
+
+    // Замер тактов каждой строки
+    constexpr auto sampled = "{%u}/{%u}"_fs;
+    for (int i = 0; i < 10; ++i) {
+        assert((stdx::scan<sampled, stdx::instrumented<1>, uint32_t, uint32_t>("10/20")));
+    }
+    assert(stdx::scan_counters<sampled>().sampled == 10);
+    assert(stdx::scan_counters<sampled>().matched == 10);
+
+    std::ostringstream out;
+    stdx::write_scan_counters(out);
+    const std::string text = out.str();
+    assert(text.find("stdx_scan_lines_total{format=\"id={%u} level={%s} size={%u}\",result=\"failed\"} 5\n") !=
+           std::string::npos);
+    assert(text.find("stdx_scan_failures_total{format=\"{%u}/{%u}\",stage=\"literal\"} 0\n") != std::string::npos);
+    assert(text.find("field=\"2\",stage=\"conversion\",reason=\"overflow\"} 1\n") != std::string::npos);
+    assert(text.find("field=\"1\",stage=\"separator\",reason=\"literal\"} 1\n") != std::string::npos);
+    assert(text.find("field=\"2\",stage=\"separator\"") == std::string::npos);
+    assert(text.find("stdx_scan_sampled_lines_total{format=\"{%u}/{%u}\"} 10\n") != std::string::npos);
+
+    // Без политики scan не обновляет счётчики
+    assert((stdx::scan<fmt, uint32_t, std::string_view, uint16_t>("id=6 level=info size=20")));
+    assert(stdx::scan_counters<fmt>().matched == 2);
+}
+
+void test_arena() {
+    stdx::scan_arena arena(64);
+    std::string buffer = "web-01 GET /index.html 200";
+    const auto first = stdx::scan_owned<"{%s} {%s} {%s} {%u}"_fs, stdx::intern<0, 1>, std::string_view,
+                                        std::string_view, std::string_view, uint16_t>(buffer, arena);
+    assert(first);
+    // Входной буфер переиспользуется для следующей строки, значения первой строки остаются в арене
+    buffer = "web-01 GET /about.html 404";
+    const auto second = stdx::scan_owned<"{%s} {%s} {%s} {%u}"_fs, stdx::intern<0, 1>, std::string_view,
+                                         std::string_view, std::string_view, uint16_t>(buffer, arena);
+    assert(second);
+    const auto [host, method, path, status] = first->values();
+    assert(host == "web-01" && method == "GET" && path == "/index.html" && status == 200);
+    assert(std::get<2>(second->values()) == "/about.html");
+    assert(host.data() < buffer.data() || host.data() >= buffer.data() + buffer.size());
+    assert(std::get<0>(second->values()).data() == host.data());
+    assert(std::get<2>(second->values()).data() != path.data());
+
+    const auto failed = stdx::scan_owned<"{%s} {%u}"_fs, std::string_view, uint16_t>("host x", arena);
+    assert(!failed && std::string_view(failed.error().data) == "Failed to parse integer");
+    const auto constant = stdx::scan_owned<"{%s} {%u}"_fs, const std::string_view, uint16_t>("host 1", arena);
+    assert(constant && std::get<0>(constant->values()) == "host");
+
+    // Строки длиннее блока и переход между блоками
+    const std::string large(200, 'x');
+    assert(arena.store(large) == large);
+    std::vector<std::string_view> stored;
+    for (int i = 0; i < 100; ++i) {
+        stored.push_back(arena.store(std::to_string(i)));
+    }
+    for (int i = 0; i < 100; ++i) {
+        assert(stored[i] == std::to_string(i));
+    }
+
+    // После reset() память блоков используется заново, интернированные строки забываются
+    const std::size_t capacity = arena.capacity();
+    arena.reset();
+    const auto reused = arena.intern("web-01");
+    assert(reused == "web-01" && arena.intern("web-01").data() == reused.data());
+    for (int i = 0; i < 100; ++i) {
+        arena.store(std::to_string(i));
+    }
+    assert(arena.capacity() == capacity);
+
+    // Таблица интернирования растёт и не теряет строки
+    std::vector<std::string_view> hosts;
+    for (int i = 0; i < 1000; ++i) {
+        hosts.push_back(arena.intern("host-" + std::to_string(i)));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        assert(arena.intern("host-" + std::to_string(i)).data() == hosts[i].data());
+    }
+    assert(arena.intern("").empty());
+}
+
+// Сравнение {%I} с inet_pton на случайных адресах и их искажениях, разбор строки журнала
+// с меткой времени, адресом и пользовательским типом за один проход
+void test_scanners() {
+    std::uint64_t state = 0x9E3779B97F4A7C15;
+    const auto next = [&] {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    constexpr char alphabet[] = "0123456789abcdefABCDEF:.:.:";
+    for (int i = 0; i < 20000; ++i) {
+        std::string text;
+        if (i % 2 == 0) {
+            text = std::to_string(next() % 300) + '.' + std::to_string(next() % 256) + '.' +
+                   std::to_string(next() % 256) + '.' + std::to_string(next() % 260);
+        } else {
+            std::array<uint8_t, 16> bytes{};
+            for (auto& byte : bytes) {
+                byte = next() % 4 == 0 ? 0 : static_cast<uint8_t>(next());
+            }
+            char buffer[INET6_ADDRSTRLEN];
+            text = inet_ntop(AF_INET6, bytes.data(), buffer, sizeof(buffer));
+        }
+        if (next() % 2 == 0) {
+            text[next() % text.size()] = alphabet[next() % (sizeof(alphabet) - 1)];
+        }
+
+        std::array<uint8_t, 16> expected{};
+        const bool v4 = inet_pton(AF_INET, text.c_str(), expected.data()) == 1;
+        const auto parsed4 = stdx::scan<"{%I}"_fs, stdx::ipv4_address>(text);
+        assert(parsed4.has_value() == v4);
+        assert(!v4 || std::equal(expected.begin(), expected.begin() + 4, std::get<0>(parsed4->values()).bytes.begin()));
+
+        const bool v6 = inet_pton(AF_INET6, text.c_str(), expected.data()) == 1;
+        const auto parsed6 = stdx::scan<"{%I}"_fs, stdx::ipv6_address>(text);
+        assert(parsed6.has_value() == v6);
+        assert(!v6 || std::get<0>(parsed6->values()).bytes == expected);
+    }
+
+    // Граничные записи сокращения '::' и IPv4 в конце адреса
+    for (const char* text : {"1:2:3:4:5:6:7:8::", "::1:2:3:4:5:6:7:8", "1:2:3:4:5:6:7::", "::2:3:4:5:6:7:8",
+                             "1::2:3:4:5:6:7", "1:2:3:4:5:6::1.2.3.4", "1:2:3:4:5:6:7::1.2.3.4", "::1.2.3.4",
+                             "1:2:3:4:5:6:1.2.3.4", ":", "1:::2", "::ffff:1.2.3"}) {
+        std::array<uint8_t, 16> expected{};
+        const bool valid = inet_pton(AF_INET6, text, expected.data()) == 1;
+        const auto parsed = stdx::scan<"{%I}"_fs, stdx::ipv6_address>(std::string_view(text));
+        assert(parsed.has_value() == valid);
+        assert(!valid || std::get<0>(parsed->values()).bytes == expected);
+    }
+
+    const std::string line = "2024-03-15T12:30:45.250+01:00 2001:db8::1 GET 1500ms";
+    const auto result =
+        stdx::scan<"{%T} {%I} {%s} {%D}"_fs, sys_ms, stdx::ipv6_address, std::string_view, duration_ms>(line);
+    assert(result.has_value());
+    const auto [time, client, method, latency] = result->values();
+    assert(time == sys_ms{std::chrono::sys_days{2024y / 3 / 15} + 11h + 30min + 45s + 250ms});
+    assert(client.bytes[0] == 0x20 && client.bytes[1] == 0x01 && client.bytes[15] == 1);
+    assert(method == "GET" && latency.value == 1500);
+
+    const auto broken = stdx::scan<"{%T} {%I} {%s} {%D}"_fs, sys_ms, stdx::ipv6_address, std::string_view, duration_ms>(
+        "2024-03-15T12:30:45.250+01:00 2001:db8::1 GET 1500");
+    assert(!broken && std::string_view(broken.error().data) == "Failed to parse duration");
+}
+
 int main() {
+    test_runtime_scan();
+    test_parse_integer();
+    test_literal_searcher();
+    test_scan_lines();
+    test_scan_lines_parallel();
+    test_scan_columns();
+    test_stream_scanner();
+    test_scan_stream();
+    test_scan_any();
+    test_fixed_width();
+    test_scan_lazy();
+    test_discard_fields();
+    test_scan_into();
+    test_keywords();
+    test_floats();
+    test_radix();
+    test_match();
+    test_instrumentation();
+    test_arena();
+    test_scanners();
     std::cout << "All tests passed at compile-time!" << std::endl;
     return 0;
 }
\ No newline at end of file